@@ -1,10 +1,27 @@
 #ifndef EPIWORLD_ADJLIST_BONES_HPP
 #define EPIWORLD_ADJLIST_BONES_HPP
 
+/**
+ * @brief Adjacency list
+ * 
+ * @details The lists are stored in compressed sparse row (CSR) format: the
+ * neighbors of vertex `i` (sorted, without duplicates) are
+ * `ids[offsets[i]]` to `ids[offsets[i + 1] - 1]`, and `counts` holds the
+ * number of times each tie was listed. `get_dat()` switches to one
+ * `std::map<int,int>` per vertex (so the ties can be modified,) and
+ * `flatten()` switches back.
+ */
 class AdjList {
 private:
 
     std::vector<std::map<int, int>> dat;
+
+    // CSR storage, used instead of dat when flat is true
+    std::vector< size_t > offsets;
+    std::vector< int > ids;
+    std::vector< int > counts;
+    bool flat = false;
+
     bool directed;
     epiworld_fast_uint N = 0;
     epiworld_fast_uint E = 0;
@@ -34,6 +51,7 @@ public:
     AdjList(AdjList && a); // Move constructor
     AdjList(const AdjList & a); // Copy constructor
     AdjList& operator=(const AdjList& a);
+    AdjList& operator=(AdjList&& a);
 
 
     /**
@@ -53,6 +71,51 @@ public:
         bool directed = true
         );
 
+    /**
+     * @brief Parses an edgelist file into columns
+     * 
+     * @details Each line holds the source and the target, optionally
+     * followed by a weight, separated by spaces, tabs, commas, or
+     * semicolons (other columns are ignored.) Empty lines are skipped. The
+     * file is loaded with a single read and, with OpenMP, parsed in
+     * parallel by chunks of lines.
+     * 
+     * @param fn Path to the file.
+     * @param source,target Vectors where to write the edges.
+     * @param weight If not `nullptr`, vector where to write the third
+     * column (which then is required.)
+     * @param skip Number of lines to skip (e.g., 1 if there's a header.)
+     */
+    static void read_edgelist_columns(
+        std::string fn,
+        std::vector< int > & source,
+        std::vector< int > & target,
+        std::vector< double > * weight = nullptr,
+        int skip = 0
+        );
+
+    /**
+     * @name Binary edgelists
+     * 
+     * @details Edgelists stored as a `BinaryTable` with the integer columns
+     * `source` and `target` (and the double column `weight`, if any,) which
+     * load with a single read and no parsing.
+     */
+    ///@{
+    static void write_edgelist_binary(
+        std::string fn,
+        const std::vector< int > & source,
+        const std::vector< int > & target,
+        const std::vector< double > * weight = nullptr
+        );
+
+    void read_edgelist_binary(
+        std::string fn,
+        int size,
+        bool directed = true
+        );
+    ///@}
+
     std::map<int, int> operator()(
         epiworld_fast_uint i
         ) const;
@@ -61,9 +124,24 @@ public:
     size_t vcount() const; ///< Number of vertices/nodes in the network.
     size_t ecount() const; ///< Number of edges/arcs/ties in the network.
     
-    std::vector<std::map<int,int>> & get_dat() {
-        return dat;
-    };
+    /**
+     * @brief Ties as one map per vertex (neighbor id -> count)
+     * @details Converts the CSR storage into maps, which can be modified.
+     */
+    std::vector<std::map<int,int>> & get_dat();
+
+    /**
+     * @name CSR storage
+     * @details `flatten()` converts the maps from `get_dat()` (if any) back
+     * into the CSR arrays, which are then available through the getters.
+     */
+    ///@{
+    void flatten();
+    bool is_flat() const noexcept;
+    const std::vector< size_t > & get_offsets() const;
+    const std::vector< int > & get_ids() const;
+    const std::vector< int > & get_counts() const;
+    ///@}
 
     bool is_directed() const; ///< `true` if the network is directed.
 
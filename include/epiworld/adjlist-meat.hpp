@@ -8,49 +8,113 @@ inline AdjList::AdjList(
     bool directed
 ) : directed(directed) {
 
+    if (source.size() != target.size())
+        throw std::length_error(
+            "The source (" + std::to_string(source.size()) +
+            ") and target (" + std::to_string(target.size()) +
+            ") vectors must have the same length."
+        );
 
-    dat.resize(size, std::map<int,int>({}));
     int max_id = size - 1;
 
-    int i,j;
-    for (int m = 0; m < static_cast<int>(source.size()); ++m)
+    for (size_t m = 0u; m < source.size(); ++m)
     {
 
-        i = source[m];
-        j = target[m];
-
-        if (i > max_id)
+        if ((source[m] < 0) || (source[m] > max_id))
             throw std::range_error(
-                "The source["+std::to_string(m)+"] = " + std::to_string(i) +
+                "The source["+std::to_string(m)+"] = " + std::to_string(source[m]) +
                 " is above the max_id " + std::to_string(max_id)
                 );
 
-        if (j > max_id)
+        if ((target[m] < 0) || (target[m] > max_id))
             throw std::range_error(
-                "The target["+std::to_string(m)+"] = " + std::to_string(j) +
+                "The target["+std::to_string(m)+"] = " + std::to_string(target[m]) +
                 " is above the max_id " + std::to_string(max_id)
                 );
 
-        // Adding nodes
-        if (dat[i].find(j) == dat[i].end())
-            dat[i].insert(std::pair<int, int>(j, 1u));
-        else
-            dat[i][j]++; 
-        
+    }
+
+    // Bucketing the ties by vertex (counting sort)
+    offsets.assign(size + 1, 0u);
+    for (size_t m = 0u; m < source.size(); ++m)
+    {
+        ++offsets[source[m] + 1];
         if (!directed)
+            ++offsets[target[m] + 1];
+    }
+
+    for (int i = 0; i < size; ++i)
+        offsets[i + 1] += offsets[i];
+
+    ids.resize(offsets[size]);
+    std::vector< size_t > cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t m = 0u; m < source.size(); ++m)
+    {
+        ids[cursor[source[m]]++] = target[m];
+        if (!directed)
+            ids[cursor[target[m]]++] = source[m];
+    }
+
+    // Sorting each list and counting the duplicates. Lists are independent,
+    // so they are processed in parallel.
+    counts.resize(ids.size());
+    std::vector< size_t > nunique(size, 0u);
+
+    #if defined(_OPENMP) || defined(__OPENMP)
+    #pragma omp parallel for schedule(dynamic, 1024) if(size > 100000)
+    #endif
+    for (int i = 0; i < size; ++i)
+    {
+
+        size_t first = offsets[i];
+        size_t last  = offsets[i + 1];
+
+        std::sort(ids.begin() + first, ids.begin() + last);
+
+        size_t n = 0u;
+        for (size_t k = first; k < last; ++k)
         {
 
-            if (dat[j].find(i) == dat[j].end())
-                dat[j].insert(std::pair<int, int>(i, 1u));
-            else
-                dat[j][i]++;
+            if ((n > 0u) && (ids[first + n - 1u] == ids[k]))
+            {
+                ++counts[first + n - 1u];
+                continue;
+            }
+
+            ids[first + n]    = ids[k];
+            counts[first + n] = 1;
+            ++n;
 
         }
 
-        E++;
+        nunique[i] = n;
+
+    }
+
+    // Since lists only shrink, they can be compacted in place
+    size_t nties = 0u;
+    for (int i = 0; i < size; ++i)
+    {
+
+        size_t first = offsets[i];
+        offsets[i] = nties;
+        for (size_t k = 0u; k < nunique[i]; ++k)
+        {
+            ids[nties]    = ids[first + k];
+            counts[nties] = counts[first + k];
+            ++nties;
+        }
 
     }
 
+    offsets[size] = nties;
+    ids.resize(nties);
+    ids.shrink_to_fit();
+    counts.resize(nties);
+    counts.shrink_to_fit();
+
+    flat = true;
+    E = source.size();
     N = size;
 
     return;
@@ -60,6 +124,10 @@ inline AdjList::AdjList(
 
 inline AdjList::AdjList(AdjList && a) :
     dat(std::move(a.dat)),
+    offsets(std::move(a.offsets)),
+    ids(std::move(a.ids)),
+    counts(std::move(a.counts)),
+    flat(a.flat),
     directed(a.directed),
     N(a.N),
     E(a.E)
@@ -69,6 +137,10 @@ inline AdjList::AdjList(AdjList && a) :
 
 inline AdjList::AdjList(const AdjList & a) :
     dat(a.dat),
+    offsets(a.offsets),
+    ids(a.ids),
+    counts(a.counts),
+    flat(a.flat),
     directed(a.directed),
     N(a.N),
     E(a.E)
@@ -82,6 +154,27 @@ inline AdjList& AdjList::operator=(const AdjList& a)
         return *this;
 
     this->dat = a.dat;
+    this->offsets = a.offsets;
+    this->ids = a.ids;
+    this->counts = a.counts;
+    this->flat = a.flat;
+    this->directed = a.directed;
+    this->N = a.N;
+    this->E = a.E;
+
+    return *this;
+}
+
+inline AdjList& AdjList::operator=(AdjList&& a)
+{
+    if (this == &a)
+        return *this;
+
+    this->dat = std::move(a.dat);
+    this->offsets = std::move(a.offsets);
+    this->ids = std::move(a.ids);
+    this->counts = std::move(a.counts);
+    this->flat = a.flat;
     this->directed = a.directed;
     this->N = a.N;
     this->E = a.E;
@@ -96,63 +189,244 @@ inline void AdjList::read_edgelist(
     bool directed
 ) {
 
-    int i,j;
-    std::ifstream filei(fn);
-
-    if (!filei)
-        throw std::logic_error("The file " + fn + " was not found.");
-
-    int linenum = 0;
     std::vector< int > source_;
     std::vector< int > target_;
+    read_edgelist_columns(fn, source_, target_, nullptr, skip);
 
-    source_.reserve(1e5);
-    target_.reserve(1e5);
+    // Now using the right constructor
+    *this = AdjList(source_, target_, size, directed);
 
-    int max_id = size - 1;
+    return;
+
+}
+
+inline void AdjList::read_edgelist_columns(
+    std::string fn,
+    std::vector< int > & source,
+    std::vector< int > & target,
+    std::vector< double > * weight,
+    int skip
+) {
+
+    // Loading the file at once (the trailing zero stops the parsers)
+    std::vector< char > buffer = read_file_bytes(fn, 1u);
+    size_t nbytes = buffer.size() - 1u;
 
-    while (!filei.eof())
+    // Skipping the header
+    size_t begin = 0u;
+    for (int l = 0; (l < skip) && (begin < nbytes); ++l)
     {
+        while ((begin < nbytes) && (buffer[begin] != '\n'))
+            ++begin;
 
-        if (linenum++ < skip)
-            continue;
+        ++begin;
+    }
 
-        filei >> i >> j;
+    begin = std::min(begin, nbytes);
 
-        // Looking for exceptions
-        if (filei.bad())
-            throw std::logic_error(
-                "I/O error while reading the file " +
-                fn
-            );
+    // Splitting the file in chunks of whole lines
+    int nchunks = 1;
+    #if defined(_OPENMP) || defined(__OPENMP)
+    if ((nbytes - begin) > (1u << 20u))
+        nchunks = std::max(1, omp_get_max_threads());
+    #endif
 
-        if (filei.fail())
-            break;
+    std::vector< size_t > bounds(nchunks + 1, nbytes);
+    bounds[0] = begin;
+    for (int c = 1; c < nchunks; ++c)
+    {
 
-        if (i > max_id)
-            throw std::range_error(
-                "The source["+std::to_string(linenum)+"] = " + std::to_string(i) +
-                " is above the max_id " + std::to_string(max_id)
-                );
+        size_t b = std::max(
+            bounds[c - 1],
+            begin + (nbytes - begin) / nchunks * c
+        );
 
-        if (j > max_id)
-            throw std::range_error(
-                "The target["+std::to_string(linenum)+"] = " + std::to_string(j) +
-                " is above the max_id " + std::to_string(max_id)
-                );
+        while ((b < nbytes) && (b > begin) && (buffer[b - 1] != '\n'))
+            ++b;
 
-        source_.push_back(i);
-        target_.push_back(j);
+        bounds[c] = b;
 
     }
 
-    // Now using the right constructor
-    *this = AdjList(source_, target_, size, directed);
+    std::vector< std::vector< int > > sources(nchunks), targets(nchunks);
+    std::vector< std::vector< double > > weights(nchunks);
+    std::vector< size_t > error_at(nchunks, nbytes);
+
+    const char * dat = buffer.data();
+
+    #if defined(_OPENMP) || defined(__OPENMP)
+    #pragma omp parallel for num_threads(nchunks) schedule(static, 1)
+    #endif
+    for (int c = 0; c < nchunks; ++c)
+    {
+
+        auto & source_c = sources[c];
+        auto & target_c = targets[c];
+        auto & weight_c = weights[c];
+
+        // Rough guess of 12 bytes per line
+        source_c.reserve((bounds[c + 1] - bounds[c]) / 12u);
+        target_c.reserve((bounds[c + 1] - bounds[c]) / 12u);
+
+        auto is_sep = [](char x) -> bool {
+            return (x == ' ') || (x == '\t') || (x == ',') || (x == ';') ||
+                (x == '\r');
+        };
+
+        size_t pos = bounds[c];
+        size_t last = bounds[c + 1];
+
+        auto read_int = [&](int * x) -> bool {
+
+            while ((pos < last) && is_sep(dat[pos]))
+                ++pos;
+
+            bool neg = false;
+            if ((pos < last) && ((dat[pos] == '-') || (dat[pos] == '+')))
+                neg = dat[pos++] == '-';
+
+            if ((pos >= last) || (dat[pos] < '0') || (dat[pos] > '9'))
+                return false;
+
+            long long v = 0;
+            while ((pos < last) && (dat[pos] >= '0') && (dat[pos] <= '9'))
+                v = v * 10 + (dat[pos++] - '0');
+
+            *x = static_cast< int >(neg ? -v : v);
+
+            return (pos >= last) || is_sep(dat[pos]) || (dat[pos] == '\n');
+
+        };
+
+        while (pos < last)
+        {
+
+            // Empty lines
+            size_t line_start = pos;
+            while ((pos < last) && is_sep(dat[pos]))
+                ++pos;
+
+            if ((pos >= last) || (dat[pos] == '\n'))
+            {
+                ++pos;
+                continue;
+            }
+
+            int i, j;
+            if (!read_int(&i) || !read_int(&j))
+            {
+                error_at[c] = line_start;
+                break;
+            }
+
+            source_c.push_back(i);
+            target_c.push_back(j);
+
+            if (weight != nullptr)
+            {
+
+                while ((pos < last) && is_sep(dat[pos]))
+                    ++pos;
+
+                // strtod() would skip the end of the line
+                char * end_w = nullptr;
+                double w = (pos < last) && (dat[pos] != '\n') ?
+                    std::strtod(dat + pos, &end_w) : 0.0;
+
+                if ((end_w == nullptr) || (end_w == dat + pos) ||
+                    (static_cast< size_t >(end_w - dat) > last))
+                {
+                    error_at[c] = line_start;
+                    break;
+                }
+
+                weight_c.push_back(w);
+                pos = static_cast< size_t >(end_w - dat);
+
+            }
+
+            // Ignoring the rest of the line
+            while ((pos < last) && (dat[pos] != '\n'))
+                ++pos;
+
+            ++pos;
+
+        }
+
+    }
+
+    for (int c = 0; c < nchunks; ++c)
+    {
+
+        if (error_at[c] == nbytes)
+            continue;
+
+        size_t line = static_cast< size_t >(std::count(
+            buffer.begin(), buffer.begin() + error_at[c], '\n'
+        )) + 1u;
+
+        throw std::logic_error(
+            "Could not parse line " + std::to_string(line) + " of the file " +
+            fn + " (expected " + (weight != nullptr ? "three" : "two") +
+            " numbers.)"
+        );
+
+    }
+
+    source.clear();
+    target.clear();
+    if (weight != nullptr)
+        weight->clear();
+
+    for (int c = 0; c < nchunks; ++c)
+    {
+
+        source.insert(source.end(), sources[c].begin(), sources[c].end());
+        target.insert(target.end(), targets[c].begin(), targets[c].end());
+
+        if (weight != nullptr)
+            weight->insert(weight->end(), weights[c].begin(), weights[c].end());
+
+    }
 
     return;
 
 }
 
+inline void AdjList::write_edgelist_binary(
+    std::string fn,
+    const std::vector< int > & source,
+    const std::vector< int > & target,
+    const std::vector< double > * weight
+) {
+
+    BinaryTable table;
+    table.add_column("source", source).add_column("target", target);
+
+    if (weight != nullptr)
+        table.add_column("weight", *weight);
+
+    table.write(fn);
+
+}
+
+inline void AdjList::read_edgelist_binary(
+    std::string fn,
+    int size,
+    bool directed
+) {
+
+    BinaryTable table = BinaryTable::read(fn);
+
+    *this = AdjList(
+        table.get_int("source"),
+        table.get_int("target"),
+        size,
+        directed
+    );
+
+}
+
 inline std::map<int,int> AdjList::operator()(
     epiworld_fast_uint i
     ) const {
@@ -162,7 +436,14 @@ inline std::map<int,int> AdjList::operator()(
             "The vertex id " + std::to_string(i) + " is not in the network."
             );
 
-    return dat[i];
+    if (!flat)
+        return dat[i];
+
+    std::map<int,int> res;
+    for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+        res.emplace_hint(res.end(), ids[k], counts[k]);
+
+    return res;
 
 }
 
@@ -171,14 +452,15 @@ inline void AdjList::print(epiworld_fast_uint limit) const {
 
     epiworld_fast_uint counter = 0;
     printf_epiworld("Nodeset:\n");
-    int i = -1;
-    for (auto & n : dat)
+    for (epiworld_fast_uint i = 0u; i < N; ++i)
     {
 
         if (counter++ > limit)
             break;
 
-        printf_epiworld("  % 3i: {", ++i);
+        auto n = this->operator()(i);
+
+        printf_epiworld("  % 3i: {", static_cast<int>(i));
         int niter = 0;
         for (auto n_n : n)
             if (++niter < static_cast<int>(n.size()))
@@ -190,16 +472,100 @@ inline void AdjList::print(epiworld_fast_uint limit) const {
             }
     }
 
-    if (limit < dat.size())
+    if (limit < N)
     {
         printf_epiworld(
             "  (... skipping %i records ...)\n",
-            static_cast<int>(dat.size() - limit)
+            static_cast<int>(N - limit)
             );
     }
 
 }
 
+inline std::vector<std::map<int,int>> & AdjList::get_dat()
+{
+
+    if (!flat)
+        return dat;
+
+    dat.assign(N, std::map<int,int>({}));
+    for (size_t i = 0u; i < N; ++i)
+        for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+            dat[i].emplace_hint(dat[i].end(), ids[k], counts[k]);
+
+    offsets = std::vector< size_t >();
+    ids = std::vector< int >();
+    counts = std::vector< int >();
+    flat = false;
+
+    return dat;
+
+}
+
+inline void AdjList::flatten()
+{
+
+    if (flat)
+        return;
+
+    offsets.assign(N + 1, 0u);
+    for (size_t i = 0u; i < dat.size(); ++i)
+        offsets[i + 1] = offsets[i] + dat[i].size();
+
+    for (size_t i = dat.size(); i < N; ++i)
+        offsets[i + 1] = offsets[i];
+
+    ids.clear();
+    counts.clear();
+    ids.reserve(offsets[N]);
+    counts.reserve(offsets[N]);
+    for (const auto & d : dat)
+        for (const auto & link : d)
+        {
+            ids.push_back(link.first);
+            counts.push_back(link.second);
+        }
+
+    dat = std::vector<std::map<int,int>>();
+    flat = true;
+
+}
+
+inline bool AdjList::is_flat() const noexcept
+{
+    return flat;
+}
+
+inline const std::vector< size_t > & AdjList::get_offsets() const
+{
+
+    if (!flat)
+        throw std::logic_error("The AdjList is not flat, see AdjList::flatten().");
+
+    return offsets;
+
+}
+
+inline const std::vector< int > & AdjList::get_ids() const
+{
+
+    if (!flat)
+        throw std::logic_error("The AdjList is not flat, see AdjList::flatten().");
+
+    return ids;
+
+}
+
+inline const std::vector< int > & AdjList::get_counts() const
+{
+
+    if (!flat)
+        throw std::logic_error("The AdjList is not flat, see AdjList::flatten().");
+
+    return counts;
+
+}
+
 inline size_t AdjList::vcount() const 
 {
     return N;
@@ -212,7 +578,7 @@ inline size_t AdjList::ecount() const
 
 inline bool AdjList::is_directed() const {
 
-    if (dat.size() == 0u)
+    if (N == 0u)
         throw std::logic_error("The edgelist is empty.");
     
     return directed;
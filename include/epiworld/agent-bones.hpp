@@ -34,6 +34,9 @@ class Entity;
 template<typename TSeq>
 class Entities;
 
+template<typename TSeq>
+class Neighbors;
+
 template<typename TSeq>
 inline void default_add_virus(Event<TSeq> & a, Model<TSeq> * m);
 
@@ -81,7 +84,7 @@ class Agent {
     friend void default_change_state<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
 private:
     
-    Model<TSeq> * model;
+    Model<TSeq> * model = nullptr;
 
     std::vector< size_t > * neighbors = nullptr;
     std::vector< size_t > * neighbors_locations = nullptr;
@@ -102,6 +105,21 @@ private:
     std::vector< ToolPtr<TSeq> > tools;
     unsigned int n_tools = 0u;
 
+    /**
+     * @name Access to the neighbors' storage
+     *
+     * @details If the model stores the network in CSR format (see
+     * `Model::network_csr_on()`), `neighbors` and `neighbors_locations` are
+     * `nullptr` and the agent's neighbors are the slice
+     * `[offsets[id], offsets[id + 1])` of the model's arrays. These functions
+     * return a pointer to the first element regardless of the storage.
+     */
+    ///@{
+    size_t * neighbors_data();
+    const size_t * neighbors_data() const;
+    size_t * neighbors_locations_data();
+    ///@}
+
 public:
 
     Agent();
@@ -204,10 +222,10 @@ public:
      * @return epiworld_double 
      */
     ///@{
-    epiworld_double get_susceptibility_reduction(VirusPtr<TSeq> v, Model<TSeq> * model);
-    epiworld_double get_transmission_reduction(VirusPtr<TSeq> v, Model<TSeq> * model);
-    epiworld_double get_recovery_enhancer(VirusPtr<TSeq> v, Model<TSeq> * model);
-    epiworld_double get_death_reduction(VirusPtr<TSeq> v, Model<TSeq> * model);
+    epiworld_double get_susceptibility_reduction(const VirusPtr<TSeq> & v, Model<TSeq> * model);
+    epiworld_double get_transmission_reduction(const VirusPtr<TSeq> & v, Model<TSeq> * model);
+    epiworld_double get_recovery_enhancer(const VirusPtr<TSeq> & v, Model<TSeq> * model);
+    epiworld_double get_death_reduction(const VirusPtr<TSeq> & v, Model<TSeq> * model);
     ///@}
 
     int get_id() const; ///< Id of the individual
@@ -240,8 +258,19 @@ public:
         size_t n_other
     );
 
+    /**
+     * @name Accessing the neighbors of the agent
+     * 
+     * @details `get_neighbors()` returns a new vector of pointers at each
+     * call, whereas `get_neighbors_view()` returns a `Neighbors<TSeq>` set
+     * that iterates over the agent's neighbors (as `Agent<TSeq> &`) without
+     * allocating memory.
+     */
+    ///@{
     std::vector< Agent<TSeq> * > get_neighbors();
+    Neighbors<TSeq> get_neighbors_view();
     size_t get_n_neighbors() const;
+    ///@}
 
     void change_state(
         Model<TSeq> * model,
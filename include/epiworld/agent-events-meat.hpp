@@ -15,7 +15,30 @@ inline void default_add_virus(Event<TSeq> & a, Model<TSeq> * m)
         v->get_date() 
     );
     
-    p->virus = std::make_shared< Virus<TSeq> >(*v);
+    // Reusing a recovered virus instance when no one else holds it
+    // (avoids allocating a new one per infection.)
+    VirusPtr<TSeq> v_new = nullptr;
+    auto & pool = m->viruses_pool;
+    while (!pool.empty())
+    {
+
+        VirusPtr<TSeq> v_pooled = std::move(pool.back());
+        pool.pop_back();
+
+        if (v_pooled.use_count() == 1)
+        {
+            v_new = std::move(v_pooled);
+            break;
+        }
+
+    }
+
+    if (v_new)
+        *v_new = *v;
+    else
+        v_new = std::make_shared< Virus<TSeq> >(*v);
+
+    p->virus = std::move(v_new);
     p->virus->set_date(m->today());
     p->virus->set_agent(p);
 
@@ -60,6 +83,8 @@ inline void default_add_tool(Event<TSeq> & a, Model<TSeq> * m)
     p->tools[n_tools]->set_date(m->today());
     p->tools[n_tools]->set_agent(p, n_tools);
 
+    m->tool_effects_invalidate(static_cast< size_t >(p->id));
+
     // Change of state needs to be recorded and updated on the
     // tools.
     if (p->state_prev != p->state)
@@ -106,6 +131,9 @@ inline void default_rm_virus(Event<TSeq> & a, Model<TSeq> * model)
     model->get_db().today_virus[v->get_id()][p->state_prev]--;
     #endif
 
+    // The instance can be recycled by default_add_virus (this also
+    // releases the event's reference.)
+    model->viruses_pool.push_back(std::move(v));
     
     return;
 
@@ -127,6 +155,8 @@ inline void default_rm_tool(Event<TSeq> & a, Model<TSeq> * m)
             );
     }
 
+    m->tool_effects_invalidate(static_cast< size_t >(p->id));
+
     // Change of state needs to be recorded and updated on the
     // tools.
     if (p->state_prev != p->state)
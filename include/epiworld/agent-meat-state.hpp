@@ -50,11 +50,11 @@ inline void default_update_exposed(Agent<TSeq> * p, Model<TSeq> * m) {
 
     // Die
     auto & virus = p->get_virus();
-    m->array_double_tmp[0u] = 
+    m->get_array_double_tmp()[0u] = 
         virus->get_prob_death(m) * (1.0 - p->get_death_reduction(virus, m)); 
 
     // Recover
-    m->array_double_tmp[1u] = 
+    m->get_array_double_tmp()[1u] = 
         1.0 - (1.0 - virus->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(virus, m)); 
     
 
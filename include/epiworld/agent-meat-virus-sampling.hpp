@@ -43,21 +43,21 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto & neighbor: p->get_neighbors_view()) 
                 {
                     
-                    auto & v = neighbor->get_virus();
+                    auto & v = neighbor.get_virus();
                     if (v == nullptr)
                         continue;
                     
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
-                        (1.0 - neighbor->get_transmission_reduction(v, m)) 
+                        (1.0 - neighbor.get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                         
                 }
 
@@ -71,7 +71,7 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
                 if (which < 0)
                     return;
 
-                p->set_virus(*m->array_virus_tmp[which], m);
+                p->set_virus(*m->get_array_virus_tmp()[which], m);
 
                 return; 
             };
@@ -87,12 +87,16 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
         std::shared_ptr<std::vector<epiworld_fast_uint>> exclude_agent_bool_idx =
             std::make_shared<std::vector<epiworld_fast_uint>>(exclude);
 
+        // Initialized once (update functions may run in parallel)
+        std::shared_ptr<std::once_flag> exclude_agent_bool_init =
+            std::make_shared<std::once_flag>();
+
         std::function<void(Agent<TSeq>*,Model<TSeq>*)> sampler =
-            [exclude_agent_bool,exclude_agent_bool_idx](Agent<TSeq> * p, Model<TSeq> * m) -> void
+            [exclude_agent_bool,exclude_agent_bool_idx,exclude_agent_bool_init](Agent<TSeq> * p, Model<TSeq> * m) -> void
             {
 
                 // The first time we call it, we need to initialize the vector
-                if (exclude_agent_bool->size() == 0u)
+                std::call_once(*exclude_agent_bool_init, [&]() -> void
                 {
 
                     exclude_agent_bool->resize(m->get_states().size(), false);
@@ -110,7 +114,7 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
 
                     }
 
-                }                    
+                });
 
                 if (p->get_virus() != nullptr)
                     throw std::logic_error(
@@ -121,26 +125,26 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto & neighbor: p->get_neighbors_view()) 
                 {
 
                     // If the state is in the list, exclude it
-                    if (exclude_agent_bool->operator[](neighbor->get_state()))
+                    if (exclude_agent_bool->operator[](neighbor.get_state()))
                         continue;
 
-                    auto & v = neighbor->get_virus();
+                    auto & v = neighbor.get_virus();
                     if (v == nullptr)
                         continue;
                             
                 
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
-                        (1.0 - neighbor->get_transmission_reduction(v, m)) 
+                        (1.0 - neighbor.get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                     
                 }
 
@@ -154,7 +158,7 @@ inline std::function<void(Agent<TSeq>*,Model<TSeq>*)> make_update_susceptible(
                 if (which < 0)
                     return;
 
-                p->set_virus(*m->array_virus_tmp[which], m); 
+                p->set_virus(*m->get_array_virus_tmp()[which], m); 
 
                 return;
 
@@ -199,27 +203,27 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto & neighbor: p->get_neighbors_view()) 
                 {
                     
-                    if (neighbor->get_virus() == nullptr)
+                    if (neighbor.get_virus() == nullptr)
                         continue;
 
-                    auto & v = neighbor->get_virus();
+                    auto & v = neighbor.get_virus();
 
                     #ifdef EPI_DEBUG
-                    if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                    if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                         throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                     #endif
                         
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
-                        (1.0 - neighbor->get_transmission_reduction(v, m)) 
+                        (1.0 - neighbor.get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                     
                 }
 
@@ -233,7 +237,7 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
                 if (which < 0)
                     return nullptr;
 
-                return m->array_virus_tmp[which]; 
+                return m->get_array_virus_tmp()[which]; 
 
             };
 
@@ -249,12 +253,16 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
         std::shared_ptr<std::vector<epiworld_fast_uint>> exclude_agent_bool_idx =
             std::make_shared<std::vector<epiworld_fast_uint>>(exclude);
 
+        // Initialized once (update functions may run in parallel)
+        std::shared_ptr<std::once_flag> exclude_agent_bool_init =
+            std::make_shared<std::once_flag>();
+
 
         std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> res = 
-            [exclude_agent_bool,exclude_agent_bool_idx](Agent<TSeq> * p, Model<TSeq> * m) -> Virus<TSeq>* {
+            [exclude_agent_bool,exclude_agent_bool_idx,exclude_agent_bool_init](Agent<TSeq> * p, Model<TSeq> * m) -> Virus<TSeq>* {
 
                 // The first time we call it, we need to initialize the vector
-                if (exclude_agent_bool->size() == 0u)
+                std::call_once(*exclude_agent_bool_init, [&]() -> void
                 {
 
                     exclude_agent_bool->resize(m->get_states().size(), false);
@@ -272,7 +280,7 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
 
                     }
 
-                }    
+                });
                 
                 if (p->get_virus() != nullptr)
                     throw std::logic_error(
@@ -283,31 +291,31 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
 
                 // This computes the prob of getting any neighbor variant
                 size_t nviruses_tmp = 0u;
-                for (auto & neighbor: p->get_neighbors()) 
+                for (auto & neighbor: p->get_neighbors_view()) 
                 {
 
                     // If the state is in the list, exclude it
-                    if (exclude_agent_bool->operator[](neighbor->get_state()))
+                    if (exclude_agent_bool->operator[](neighbor.get_state()))
                         continue;
 
-                    if (neighbor->get_virus() == nullptr)
+                    if (neighbor.get_virus() == nullptr)
                         continue;
 
-                    auto & v = neighbor->get_virus();
+                    auto & v = neighbor.get_virus();
                             
                     #ifdef EPI_DEBUG
-                    if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                    if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                         throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                     #endif
                         
                     /* And it is a function of susceptibility_reduction as well */ 
-                    m->array_double_tmp[nviruses_tmp] =
+                    m->get_array_double_tmp()[nviruses_tmp] =
                         (1.0 - p->get_susceptibility_reduction(v, m)) * 
                         v->get_prob_infecting(m) * 
-                        (1.0 - neighbor->get_transmission_reduction(v, m)) 
+                        (1.0 - neighbor.get_transmission_reduction(v, m)) 
                         ; 
                 
-                    m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                    m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
                     
                 }
 
@@ -321,7 +329,7 @@ inline std::function<Virus<TSeq>*(Agent<TSeq>*,Model<TSeq>*)> make_sample_virus_
                 if (which < 0)
                     return nullptr;
 
-                return m->array_virus_tmp[which]; 
+                return m->get_array_virus_tmp()[which]; 
 
             };
 
@@ -360,42 +368,42 @@ inline Virus<TSeq> * sample_virus_single(Agent<TSeq> * p, Model<TSeq> * m)
 
     // This computes the prob of getting any neighbor variant
     size_t nviruses_tmp = 0u;
-    for (auto & neighbor: p->get_neighbors()) 
+    for (auto & neighbor: p->get_neighbors_view()) 
     {   
         #ifdef EPI_DEBUG
         int _vcount_neigh = 0;
         #endif                
 
-        if (neighbor->get_virus() == nullptr)
+        if (neighbor.get_virus() == nullptr)
             continue;
 
-        auto & v = neighbor->get_virus();
+        auto & v = neighbor.get_virus();
 
         #ifdef EPI_DEBUG
-        if (nviruses_tmp >= m->array_virus_tmp.size())
+        if (nviruses_tmp >= m->get_array_virus_tmp().size())
             throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
         #endif
             
         /* And it is a function of susceptibility_reduction as well */ 
-        m->array_double_tmp[nviruses_tmp] =
+        m->get_array_double_tmp()[nviruses_tmp] =
             (1.0 - p->get_susceptibility_reduction(v, m)) * 
             v->get_prob_infecting(m) * 
-            (1.0 - neighbor->get_transmission_reduction(v, m)) 
+            (1.0 - neighbor.get_transmission_reduction(v, m)) 
             ; 
     
-        m->array_virus_tmp[nviruses_tmp++] = &(*v);
+        m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
 
         #ifdef EPI_DEBUG
         if (
-            (m->array_double_tmp[nviruses_tmp - 1] < 0.0) |
-            (m->array_double_tmp[nviruses_tmp - 1] > 1.0)
+            (m->get_array_double_tmp()[nviruses_tmp - 1] < 0.0) |
+            (m->get_array_double_tmp()[nviruses_tmp - 1] > 1.0)
             )
         {
             printf_epiworld(
                 "[epi-debug] Agent %i's virus %i has transmission prob outside of [0, 1]: %.4f!\n",
-                static_cast<int>(neighbor->get_id()),
+                static_cast<int>(neighbor.get_id()),
                 static_cast<int>(_vcount_neigh++),
-                m->array_double_tmp[nviruses_tmp - 1]
+                m->get_array_double_tmp()[nviruses_tmp - 1]
                 );
         }
         #endif
@@ -421,7 +429,7 @@ inline Virus<TSeq> * sample_virus_single(Agent<TSeq> * p, Model<TSeq> * m)
     m->get_db().n_transmissions_today++;
     #endif
 
-    return m->array_virus_tmp[which]; 
+    return m->get_array_virus_tmp()[which]; 
     
 }
 
@@ -30,9 +30,13 @@ inline Agent<TSeq>::Agent(Agent<TSeq> && p) :
     n_tools(p.n_tools)
 {
 
+    // The neighbors are now owned by this agent
+    p.neighbors = nullptr;
+    p.neighbors_locations = nullptr;
+
     state = p.state;
     id     = p.id;
-    
+
     // Dealing with the virus
     if (p.virus != nullptr)
     {
@@ -62,7 +66,8 @@ inline Agent<TSeq>::Agent(const Agent<TSeq> & p) :
     n_entities(p.n_entities)
 {
 
-    if (n_neighbors > 0u)
+    // Agents in a CSR network don't own their neighbors
+    if (p.neighbors != nullptr)
     {
         neighbors = new std::vector< size_t >(*p.neighbors);
         neighbors_locations = new std::vector< size_t >(*p.neighbors_locations);
@@ -106,12 +111,17 @@ inline Agent<TSeq> & Agent<TSeq>::operator=(
     {
         delete neighbors;
         delete neighbors_locations;
+
+        neighbors = nullptr;
+        neighbors_locations = nullptr;
     }
 
-    if (other_agent.n_neighbors > 0u)
+    if (other_agent.neighbors != nullptr)
     {
-        neighbors = new std::vector< size_t >(other_agent.n_neighbors);
-        neighbors_locations = new std::vector< size_t >(other_agent.n_neighbors);
+        neighbors = new std::vector< size_t >(*other_agent.neighbors);
+        neighbors_locations = new std::vector< size_t >(
+            *other_agent.neighbors_locations
+        );
     }
     
     entities = other_agent.entities;
@@ -153,6 +163,48 @@ inline Agent<TSeq>::~Agent()
 
 }
 
+template<typename TSeq>
+inline size_t * Agent<TSeq>::neighbors_data()
+{
+
+    if (neighbors != nullptr)
+        return neighbors->data();
+
+    if ((model != nullptr) && model->network_csr)
+        return model->network_targets->data() + (*model->network_offsets)[id];
+
+    return nullptr;
+
+}
+
+template<typename TSeq>
+inline const size_t * Agent<TSeq>::neighbors_data() const
+{
+
+    if (neighbors != nullptr)
+        return neighbors->data();
+
+    if ((model != nullptr) && model->network_csr)
+        return model->network_targets->data() + (*model->network_offsets)[id];
+
+    return nullptr;
+
+}
+
+template<typename TSeq>
+inline size_t * Agent<TSeq>::neighbors_locations_data()
+{
+
+    if (neighbors_locations != nullptr)
+        return neighbors_locations->data();
+
+    if ((model != nullptr) && model->network_csr)
+        return model->network_locations->data() + (*model->network_offsets)[id];
+
+    return nullptr;
+
+}
+
 template<typename TSeq>
 inline void Agent<TSeq>::add_tool(
     ToolPtr<TSeq> tool,
@@ -171,7 +223,7 @@ inline void Agent<TSeq>::add_tool(
     CHECK_COALESCE_(queue, tool->queue_init, Queue<TSeq>::NoOne);
 
     model->events_add(
-        this, nullptr, tool, nullptr, state_new, queue, default_add_tool<TSeq>, -1, -1
+        this, nullptr, tool, nullptr, state_new, queue, EventType::add_tool, -1, -1
         );
 
 }
@@ -207,7 +259,7 @@ inline void Agent<TSeq>::set_virus(
     CHECK_COALESCE_(queue, virus->queue_init, Queue<TSeq>::NoOne);
 
     model->events_add(
-        this, virus, nullptr, nullptr, state_new, queue, default_add_virus<TSeq>, -1, -1
+        this, virus, nullptr, nullptr, state_new, queue, EventType::add_virus, -1, -1
         );
 
 }
@@ -240,7 +292,7 @@ inline void Agent<TSeq>::add_entity(
     {
 
         model->events_add(
-            this, nullptr, nullptr, &entity, state_new, queue, default_add_entity<TSeq>, -1, -1
+            this, nullptr, nullptr, &entity, state_new, queue, EventType::add_entity, -1, -1
         );
 
     }
@@ -249,8 +301,8 @@ inline void Agent<TSeq>::add_entity(
     {
 
         Event<TSeq> a(
-                this, nullptr, nullptr, &entity, state_new, queue, default_add_entity<TSeq>,
-                -1, -1
+                this, nullptr, nullptr, &entity, state_new, queue, -1, -1,
+                EventType::add_entity
             );
 
         default_add_entity(a, model); /* passing model makes nothing */
@@ -278,7 +330,7 @@ inline void Agent<TSeq>::rm_tool(
         );
 
     model->events_add(
-        this, nullptr, tools[tool_idx], nullptr, state_new, queue, default_rm_tool<TSeq>, -1, -1
+        this, nullptr, tools[tool_idx], nullptr, state_new, queue, EventType::rm_tool, -1, -1
         );
 
 }
@@ -296,7 +348,7 @@ inline void Agent<TSeq>::rm_tool(
         throw std::logic_error("Cannot remove a virus from another agent!");
 
     model->events_add(
-        this, nullptr, tool, nullptr, state_new, queue, default_rm_tool<TSeq>, -1, -1
+        this, nullptr, tool, nullptr, state_new, queue, EventType::rm_tool, -1, -1
         );
 
 }
@@ -319,7 +371,7 @@ inline void Agent<TSeq>::rm_virus(
 
     model->events_add(
         this, virus, nullptr, nullptr, state_new, queue,
-        default_rm_virus<TSeq>, -1, -1
+        EventType::rm_virus, -1, -1
         );
     
 }
@@ -353,7 +405,7 @@ inline void Agent<TSeq>::rm_entity(
         &model->get_entity(entity_idx),
         state_new,
         queue, 
-        default_rm_entity<TSeq>,
+        EventType::rm_entity,
         entities_locations[entity_idx],
         entity_idx
     );
@@ -398,7 +450,7 @@ inline void Agent<TSeq>::rm_entity(
         &model->entities[entity.get_id()],
         state_new,
         queue, 
-        default_rm_entity<TSeq>,
+        EventType::rm_entity,
         entities_locations[entity_idx],
         entity_idx
     );
@@ -417,41 +469,53 @@ inline void Agent<TSeq>::rm_agent_by_virus(
 
     model->events_add(
         this, virus, nullptr, nullptr, state_new, queue,
-        default_rm_virus<TSeq>, -1, -1
+        EventType::rm_virus, -1, -1
         );
 
 }
 
 template<typename TSeq>
 inline epiworld_double Agent<TSeq>::get_susceptibility_reduction(
-    VirusPtr<TSeq> v,
+    const VirusPtr<TSeq> & v,
     Model<TSeq> * model
 ) {
 
+    if (model->tool_effects_cache)
+        return model->tool_effect(this, v, Model<TSeq>::TOOL_EFFECT_SUSCEPTIBILITY);
+
     return model->susceptibility_reduction_mixer(this, v, model);
 }
 
 template<typename TSeq>
 inline epiworld_double Agent<TSeq>::get_transmission_reduction(
-    VirusPtr<TSeq> v,
+    const VirusPtr<TSeq> & v,
     Model<TSeq> * model
 ) {
+    if (model->tool_effects_cache)
+        return model->tool_effect(this, v, Model<TSeq>::TOOL_EFFECT_TRANSMISSION);
+
     return model->transmission_reduction_mixer(this, v, model);
 }
 
 template<typename TSeq>
 inline epiworld_double Agent<TSeq>::get_recovery_enhancer(
-    VirusPtr<TSeq> v,
+    const VirusPtr<TSeq> & v,
     Model<TSeq> * model
 ) {
+    if (model->tool_effects_cache)
+        return model->tool_effect(this, v, Model<TSeq>::TOOL_EFFECT_RECOVERY);
+
     return model->recovery_enhancer_mixer(this, v, model);
 }
 
 template<typename TSeq>
 inline epiworld_double Agent<TSeq>::get_death_reduction(
-    VirusPtr<TSeq> v,
+    const VirusPtr<TSeq> & v,
     Model<TSeq> * model
 ) {
+    if (model->tool_effects_cache)
+        return model->tool_effect(this, v, Model<TSeq>::TOOL_EFFECT_DEATH);
+
     return model->death_reduction_mixer(this, v, model);
 }
 
@@ -508,6 +572,17 @@ inline void Agent<TSeq>::add_neighbor(
     bool check_source,
     bool check_target
 ) {
+
+    if ((model != nullptr) && model->network_csr)
+        throw std::logic_error(
+            "Neighbors cannot be added one at a time when the network is " +
+            std::string("stored in CSR format. Build the network with ") +
+            std::string("-Model::agents_from_adjlist()- or -Model::agents_from_edgelist()-.")
+        );
+
+    if (model != nullptr)
+        model->network_modified = true;
+
     // Can we find the neighbor?
     bool found = false;
 
@@ -593,31 +668,42 @@ inline void Agent<TSeq>::swap_neighbors(
             std::to_string(other.n_neighbors) + " neighbors."
         );
 
+    model->network_modified = true;
+
+    // The CSR arrays may be shared with other copies of the model
+    if (model->network_csr)
+        model->network_csr_unshare();
+
     // Getting the agents
     auto & pop = model->population;
-    auto & neigh_this  = pop[(*neighbors)[n_this]];
-    auto & neigh_other = pop[(*other.neighbors)[n_other]];
+    size_t * neigh_ids_this  = neighbors_data();
+    size_t * neigh_ids_other = other.neighbors_data();
+    size_t * neigh_locs_this  = neighbors_locations_data();
+    size_t * neigh_locs_other = other.neighbors_locations_data();
+
+    auto & neigh_this  = pop[neigh_ids_this[n_this]];
+    auto & neigh_other = pop[neigh_ids_other[n_other]];
 
     // Getting the locations in the neighbors
-    size_t loc_this_in_neigh = (*neighbors_locations)[n_this];
-    size_t loc_other_in_neigh = (*other.neighbors_locations)[n_other];
+    size_t loc_this_in_neigh = neigh_locs_this[n_this];
+    size_t loc_other_in_neigh = neigh_locs_other[n_other];
 
     // Changing ids
-    std::swap((*neighbors)[n_this], (*other.neighbors)[n_other]);
+    std::swap(neigh_ids_this[n_this], neigh_ids_other[n_other]);
 
     if (!model->directed)
     {
         std::swap(
-            (*neigh_this.neighbors)[loc_this_in_neigh],
-            (*neigh_other.neighbors)[loc_other_in_neigh]
+            neigh_this.neighbors_data()[loc_this_in_neigh],
+            neigh_other.neighbors_data()[loc_other_in_neigh]
             );
 
         // Changing the locations
-        std::swap((*neighbors_locations)[n_this], (*other.neighbors_locations)[n_other]);
+        std::swap(neigh_locs_this[n_this], neigh_locs_other[n_other]);
         
         std::swap(
-            (*neigh_this.neighbors_locations)[loc_this_in_neigh],
-            (*neigh_other.neighbors_locations)[loc_other_in_neigh]
+            neigh_this.neighbors_locations_data()[loc_this_in_neigh],
+            neigh_other.neighbors_locations_data()[loc_other_in_neigh]
             );
     }
 
@@ -627,12 +713,19 @@ template<typename TSeq>
 inline std::vector< Agent<TSeq> *> Agent<TSeq>::get_neighbors()
 {
     std::vector< Agent<TSeq> * > res(n_neighbors, nullptr);
+    const size_t * neigh_ids = neighbors_data();
     for (size_t i = 0u; i < n_neighbors; ++i)
-        res[i] = &model->population[(*neighbors)[i]];
+        res[i] = &model->population[neigh_ids[i]];
 
     return res;
 }
 
+template<typename TSeq>
+inline Neighbors<TSeq> Agent<TSeq>::get_neighbors_view()
+{
+    return Neighbors<TSeq>(model->population.data(), neighbors_data(), n_neighbors);
+}
+
 template<typename TSeq>
 inline size_t Agent<TSeq>::get_n_neighbors() const
 {
@@ -649,7 +742,7 @@ inline void Agent<TSeq>::change_state(
 
     model->events_add(
         this, nullptr, nullptr, nullptr, new_state, queue,
-        default_change_state<TSeq>, -1, -1
+        EventType::change_state, -1, -1
     );
     
     return;
@@ -913,10 +1006,12 @@ inline bool Agent<TSeq>::operator==(const Agent<TSeq> & other) const
         )
 
     
+    const size_t * neigh_ids = neighbors_data();
+    const size_t * neigh_ids_other = other.neighbors_data();
     for (size_t i = 0u; i < n_neighbors; ++i)
     {
         EPI_DEBUG_FAIL_AT_TRUE(
-            neighbors[i] != other.neighbors[i],
+            neigh_ids[i] != neigh_ids_other[i],
             "Agent:: neighbor[i] don't match"
         )
     }
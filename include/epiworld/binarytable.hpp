@@ -0,0 +1,367 @@
+#ifndef EPIWORLD_BINARYTABLE_HPP
+#define EPIWORLD_BINARYTABLE_HPP
+
+/**
+ * @brief Columnar table stored in a binary file
+ *
+ * @details Used by `DataBase::write_data_binary()` as a faster alternative
+ * to the text files written by `DataBase::write_data()`. A table is a set
+ * of named columns of the same length, either integers (stored as 32-bit)
+ * or doubles (stored as 64-bit.) Integer columns can have labels (e.g.,
+ * the state names,) in which case the values are indices into the labels.
+ *
+ * The file has the following layout (all numbers little-endian):
+ * - The magic string `EPIWBIN1` (8 bytes.)
+ * - Number of columns (uint32) and number of rows (uint64.)
+ * - For each column: the name (uint32 length followed by the characters,)
+ *   the type (uint8, `BinaryTable::INT32` or `BinaryTable::FLOAT64`,) and
+ *   the labels (uint32 count, followed by each label as a name.)
+ * - The data of each column, one after the other.
+ */
+class BinaryTable {
+private:
+
+    std::vector< std::string > names;
+    std::vector< unsigned char > types;
+    std::vector< std::vector< std::string > > labels;
+
+    // Position of each column in `cols_int` or `cols_double`
+    std::vector< size_t > locations;
+    std::vector< std::vector< int > > cols_int;
+    std::vector< std::vector< double > > cols_double;
+
+    size_t n_rows = 0u;
+
+    void check_nrows(size_t n, const std::string & name);
+    size_t get_column(const std::string & name, unsigned char type) const;
+
+public:
+
+    static constexpr unsigned char INT32   = 1u;
+    static constexpr unsigned char FLOAT64 = 2u;
+
+    BinaryTable() {};
+
+    /**
+     * @brief Adds a column to the table.
+     * @param name Name of the column.
+     * @param x Data (all columns must have the same length.)
+     * @param labels_ Labels of the values (optional, integers only.)
+     */
+    ///@{
+    BinaryTable & add_column(
+        std::string name,
+        const std::vector< int > & x,
+        std::vector< std::string > labels_ = {}
+        );
+
+    BinaryTable & add_column(
+        std::string name,
+        const std::vector< double > & x
+        );
+    ///@}
+
+    size_t nrow() const noexcept; ///< Number of rows.
+    size_t ncol() const noexcept; ///< Number of columns.
+
+    /**
+     * @name Retrieve the columns by name
+     * @details Throws an exception if the column does not exist or if the
+     * type doesn't match.
+     */
+    ///@{
+    const std::vector< std::string > & get_names() const;
+    unsigned char get_type(const std::string & name) const;
+    const std::vector< int > & get_int(const std::string & name) const;
+    const std::vector< double > & get_double(const std::string & name) const;
+    const std::vector< std::string > & get_labels(const std::string & name) const;
+    ///@}
+
+    /**
+     * @brief Writes and reads the table.
+     * @param fn File name.
+     */
+    ///@{
+    void write(std::string fn) const;
+    static BinaryTable read(std::string fn);
+    ///@}
+
+};
+
+inline void BinaryTable::check_nrows(size_t n, const std::string & name)
+{
+
+    if ((names.size() != 0u) && (n != n_rows))
+        throw std::length_error(
+            "The column \"" + name + "\" has " + std::to_string(n) +
+            " rows, while the table has " + std::to_string(n_rows) + "."
+        );
+
+    n_rows = n;
+
+}
+
+inline BinaryTable & BinaryTable::add_column(
+    std::string name,
+    const std::vector< int > & x,
+    std::vector< std::string > labels_
+) {
+
+    check_nrows(x.size(), name);
+
+    names.push_back(name);
+    types.push_back(INT32);
+    labels.push_back(labels_);
+    locations.push_back(cols_int.size());
+    cols_int.push_back(x);
+
+    return *this;
+
+}
+
+inline BinaryTable & BinaryTable::add_column(
+    std::string name,
+    const std::vector< double > & x
+) {
+
+    check_nrows(x.size(), name);
+
+    names.push_back(name);
+    types.push_back(FLOAT64);
+    labels.push_back({});
+    locations.push_back(cols_double.size());
+    cols_double.push_back(x);
+
+    return *this;
+
+}
+
+inline size_t BinaryTable::nrow() const noexcept
+{
+    return n_rows;
+}
+
+inline size_t BinaryTable::ncol() const noexcept
+{
+    return names.size();
+}
+
+inline const std::vector< std::string > & BinaryTable::get_names() const
+{
+    return names;
+}
+
+inline size_t BinaryTable::get_column(
+    const std::string & name,
+    unsigned char type
+) const {
+
+    for (size_t i = 0u; i < names.size(); ++i)
+    {
+
+        if (names[i] != name)
+            continue;
+
+        if ((type != 0u) && (types[i] != type))
+            throw std::logic_error(
+                "The column \"" + name + "\" is of type " +
+                std::to_string(types[i]) + "."
+            );
+
+        return i;
+
+    }
+
+    throw std::range_error("The column \"" + name + "\" does not exist.");
+
+}
+
+inline unsigned char BinaryTable::get_type(const std::string & name) const
+{
+    return types[get_column(name, 0u)];
+}
+
+inline const std::vector< int > & BinaryTable::get_int(
+    const std::string & name
+) const {
+    return cols_int[locations[get_column(name, INT32)]];
+}
+
+inline const std::vector< double > & BinaryTable::get_double(
+    const std::string & name
+) const {
+    return cols_double[locations[get_column(name, FLOAT64)]];
+}
+
+inline const std::vector< std::string > & BinaryTable::get_labels(
+    const std::string & name
+) const {
+    return labels[get_column(name, 0u)];
+}
+
+inline void BinaryTable::write(std::string fn) const
+{
+
+    std::ofstream file(fn, std::ios_base::out | std::ios_base::binary);
+
+    if (!file)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for writing."
+        );
+
+    std::vector< unsigned char > buffer;
+
+    auto put = [&buffer](uint64_t x, size_t nbytes) -> void {
+        for (size_t b = 0u; b < nbytes; ++b)
+            buffer.push_back(static_cast< unsigned char >(x >> (8u * b)));
+    };
+
+    auto put_string = [&buffer, &put](const std::string & s) -> void {
+        put(static_cast< uint64_t >(s.size()), 4u);
+        buffer.insert(buffer.end(), s.begin(), s.end());
+    };
+
+    // Header
+    const char magic[] = "EPIWBIN1";
+    buffer.insert(buffer.end(), magic, magic + 8);
+    put(static_cast< uint64_t >(names.size()), 4u);
+    put(static_cast< uint64_t >(n_rows), 8u);
+
+    for (size_t i = 0u; i < names.size(); ++i)
+    {
+
+        put_string(names[i]);
+        buffer.push_back(types[i]);
+        put(static_cast< uint64_t >(labels[i].size()), 4u);
+
+        for (const auto & l : labels[i])
+            put_string(l);
+
+    }
+
+    file.write(
+        reinterpret_cast< const char * >(buffer.data()),
+        static_cast< std::streamsize >(buffer.size())
+    );
+
+    // Data, one column at a time
+    for (size_t i = 0u; i < names.size(); ++i)
+    {
+
+        buffer.clear();
+
+        if (types[i] == INT32)
+        {
+
+            buffer.reserve(n_rows * 4u);
+            for (auto x : cols_int[locations[i]])
+                put(static_cast< uint32_t >(static_cast< int32_t >(x)), 4u);
+
+        }
+        else
+        {
+
+            buffer.reserve(n_rows * 8u);
+            for (auto x : cols_double[locations[i]])
+            {
+                uint64_t bits;
+                std::memcpy(&bits, &x, sizeof(bits));
+                put(bits, 8u);
+            }
+
+        }
+
+        file.write(
+            reinterpret_cast< const char * >(buffer.data()),
+            static_cast< std::streamsize >(buffer.size())
+        );
+
+    }
+
+    if (!file)
+        throw std::runtime_error("Error while writing to \"" + fn + "\".");
+
+}
+
+inline BinaryTable BinaryTable::read(std::string fn)
+{
+
+    std::vector< unsigned char > buffer =
+        read_file_bytes< unsigned char >(fn);
+
+    ByteReader reader(buffer, fn);
+
+    if (!reader.check_magic("EPIWBIN1"))
+        throw std::runtime_error(
+            "The file \"" + fn + "\" is not an epiworld binary table."
+        );
+
+    size_t ncols = static_cast< size_t >(reader.get(4u));
+    size_t nrows = static_cast< size_t >(reader.get(8u));
+
+    // Each column header takes at least 9 bytes
+    reader.need(ncols, 9u);
+
+    std::vector< std::string > names(ncols);
+    std::vector< unsigned char > types(ncols);
+    std::vector< std::vector< std::string > > labels(ncols);
+    for (size_t i = 0u; i < ncols; ++i)
+    {
+
+        names[i] = reader.get_string();
+        types[i] = static_cast< unsigned char >(reader.get(1u));
+
+        if ((types[i] != INT32) && (types[i] != FLOAT64))
+            throw std::runtime_error(
+                "The column \"" + names[i] + "\" in \"" + fn +
+                "\" has an unknown type."
+            );
+
+        size_t nlabels = static_cast< size_t >(reader.get(4u));
+        for (size_t l = 0u; l < nlabels; ++l)
+            labels[i].push_back(reader.get_string());
+
+    }
+
+    BinaryTable table;
+    for (size_t i = 0u; i < ncols; ++i)
+    {
+
+        if (types[i] == INT32)
+        {
+
+            reader.need(nrows, 4u);
+            std::vector< int > x(nrows);
+            for (auto & v : x)
+                v = static_cast< int >(static_cast< int32_t >(
+                    static_cast< uint32_t >(reader.get(4u))
+                    ));
+
+            table.add_column(names[i], x, labels[i]);
+
+        }
+        else
+        {
+
+            reader.need(nrows, 8u);
+            std::vector< double > x(nrows);
+            for (auto & v : x)
+            {
+                uint64_t bits = reader.get(8u);
+                std::memcpy(&v, &bits, sizeof(bits));
+            }
+
+            table.add_column(names[i], x);
+
+        }
+
+    }
+
+    // Zero-column tables keep their number of rows
+    table.n_rows = nrows;
+
+    return table;
+
+}
+
+#endif
@@ -118,6 +118,38 @@ using ToolToAgentFun = std::function<void(Tool<TSeq>&,Model<TSeq>*)>;
 template<typename TSeq = EPI_DEFAULT_TSEQ>
 using EntityToAgentFun = std::function<void(Entity<TSeq>&,Model<TSeq>*)>;
 
+/**
+ * @brief Receives chunks of transmission records (see
+ * `DataBase::transmission_stream_on()`.) The arguments are the date, source,
+ * target, virus, and source exposure date columns.
+ */
+using TransmissionSink = std::function<void(
+    const std::vector< int > &,
+    const std::vector< int > &,
+    const std::vector< int > &,
+    const std::vector< int > &,
+    const std::vector< int > &
+    )>;
+
+/**
+ * @brief Built-in event types
+ * 
+ * @details Events of a built-in type are dispatched by
+ * `Model::events_run()` with a `switch`. User-defined events are of type
+ * `custom`; their function is stored by the model, and the event only keeps
+ * its index (`Event::idx_call`.)
+ */
+enum class EventType : int {
+    custom,
+    add_virus,
+    rm_virus,
+    add_tool,
+    rm_tool,
+    add_entity,
+    rm_entity,
+    change_state
+};
+
 /**
  * @brief Event data for update an agent
  * 
@@ -131,9 +163,10 @@ struct Event {
     Entity<TSeq> * entity;
     epiworld_fast_int new_state;
     epiworld_fast_int queue;
-    EventFun<TSeq> call;
     int idx_agent;
     int idx_object;
+    EventType type;
+    int idx_call;
 public:
 /**
      * @brief Construct a new Event object
@@ -143,13 +176,13 @@ public:
      * @param agent_ Agent over who the action will happen
      * @param virus_ Virus to add
      * @param tool_ Tool to add
-     * @param virus_idx Index of virus to be removed (if needed)
-     * @param tool_idx Index of tool to be removed (if needed)
+     * @param entity_ Entity to add
      * @param new_state_ Next state
      * @param queue_ Efect on the queue
-     * @param call_ The action call (if needed)
      * @param idx_agent_ Location of agent in object.
      * @param idx_object_ Location of object in agent.
+     * @param type_ Type of event.
+     * @param idx_call_ Index of the model's custom function (`-1` if none.)
      */
     Event(
         Agent<TSeq> * agent_,
@@ -158,12 +191,14 @@ public:
         Entity<TSeq> * entity_,
         epiworld_fast_int new_state_,
         epiworld_fast_int queue_,
-        EventFun<TSeq> call_,
         int idx_agent_,
-        int idx_object_
+        int idx_object_,
+        EventType type_ = EventType::custom,
+        int idx_call_ = -1
     ) : agent(agent_), virus(virus_), tool(tool_), entity(entity_),
         new_state(new_state_),
-        queue(queue_), call(call_), idx_agent(idx_agent_), idx_object(idx_object_) {
+        queue(queue_), idx_agent(idx_agent_), idx_object(idx_object_),
+        type(type_), idx_call(idx_call_) {
             return;
         };
 };
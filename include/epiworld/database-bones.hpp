@@ -10,6 +10,9 @@ class Virus;
 template<typename TSeq>
 class UserData;
 
+template<typename TSeq>
+class ResultsCollector;
+
 template<typename TSeq>
 inline void default_add_virus(Event<TSeq> & a, Model<TSeq> * m);
 
@@ -22,17 +25,82 @@ inline void default_rm_virus(Event<TSeq> & a, Model<TSeq> * m);
 template<typename TSeq>
 inline void default_rm_tool(Event<TSeq> & a, Model<TSeq> * m);
 
+template<typename TSeq>
+inline void default_add_entity(Event<TSeq> & a, Model<TSeq> * m);
+
+template<typename TSeq>
+inline void default_rm_entity(Event<TSeq> & a, Model<TSeq> * m);
+
 template<typename TSeq>
 inline void default_change_state(Event<TSeq> & a, Model<TSeq> * m);
 
+/**
+ * @brief File removed when its owner is destroyed
+ *
+ * @details Holds the stream files created by copies of `DataBase`. Moving
+ * transfers the file; copying does not (the copy owns nothing), and
+ * assigning removes the file owned so far.
+ */
+class OwnedFile {
+private:
+    std::string fn = "";
+
+public:
+
+    OwnedFile() = default;
+    OwnedFile(const OwnedFile &) {};
+    OwnedFile(OwnedFile && other) noexcept : fn(std::move(other.fn))
+    {
+        other.fn.clear();
+    };
+
+    OwnedFile & operator=(const OwnedFile & other)
+    {
+        if (this != &other)
+            release();
+        return *this;
+    };
+
+    OwnedFile & operator=(OwnedFile && other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            fn = std::move(other.fn);
+            other.fn.clear();
+        }
+        return *this;
+    };
+
+    ~OwnedFile() { release(); };
+
+    void own(const std::string & fn_)
+    {
+        release();
+        fn = fn_;
+    };
+
+    /**
+     * @brief Removes the file (if any.)
+     */
+    void release() noexcept
+    {
+        if (fn != "")
+            std::remove(fn.c_str());
+        fn.clear();
+    };
+
+};
+
 /**
  * @brief Statistical data about the process
- * 
+ *
  * @tparam TSeq 
  */
 template<typename TSeq>
 class DataBase {
     friend class Model<TSeq>;
+    friend class ResultsCollector<TSeq>;
     friend void default_add_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
     friend void default_add_tool<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
     friend void default_rm_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
@@ -96,6 +164,49 @@ private:
     std::vector< int > transmission_virus;              ///< Id of the variant
     std::vector< int > transmission_source_exposure_date; ///< Date when the source acquired the variant
 
+    /**
+     * @brief Generation time of each transmission
+     * 
+     * @details Updated by `record_transmission()`: each transmission waits
+     * in a list of its target agent (`gentime_pending_head` and
+     * `gentime_pending_next`, -1 marks the end) until the target
+     * transmits the virus.
+     */
+    ///@{
+    std::vector< int > transmission_gentime;   ///< Generation time (-1 if none.)
+    std::vector< int > gentime_pending_head;   ///< Last pending transmission by agent.
+    std::vector< int > gentime_pending_next;   ///< Next pending transmission.
+    ///@}
+
+    /**
+     * @name Streaming of the transmission records
+     * 
+     * @details When `transmission_chunk_size > 0`, the transmission columns
+     * hold at most one chunk. Full chunks are appended to
+     * `transmission_stream_fn` or passed to `transmission_stream_fun`.
+     * `transmission_stream_read()` passes all the records (spilled ones
+     * first) to a function, one chunk at a time, without keeping them;
+     * `transmission_stream_load()` brings them back into the columns.
+     */
+    ///@{
+    size_t transmission_chunk_size = 0u;
+    std::string transmission_stream_fn = "";
+    TransmissionSink transmission_stream_fun = nullptr;
+    size_t transmission_n_flushed = 0u; ///< Records spilled so far.
+    std::shared_ptr< std::atomic< size_t > > transmission_stream_ncopies =
+        std::make_shared< std::atomic< size_t > >(0u); ///< Numbers the files of copies.
+    OwnedFile transmission_stream_copy; ///< File of a copy (see the copy constructor.)
+    std::shared_ptr< std::mutex > transmission_stream_mutex =
+        std::make_shared< std::mutex >(); ///< Serializes the calls to `transmission_stream_fun`.
+    void transmission_stream_load();
+    void transmission_stream_read(
+        std::function<void(
+            const int *, const int *, const int *, const int *, const int *,
+            size_t
+        )> fun
+    ) const;
+    ///@}
+
     std::vector< int > transition_matrix;
 
     UserData<TSeq> user_data;
@@ -131,7 +242,9 @@ public:
     DataBase() = delete;
     DataBase(Model<TSeq> & m) : model(&m), user_data(m) {};
     DataBase(const DataBase<TSeq> & db);
-    // DataBase<TSeq> & operator=(const DataBase<TSeq> & m);
+    DataBase(DataBase<TSeq> && db) = default;
+    DataBase<TSeq> & operator=(const DataBase<TSeq> & db);
+    DataBase<TSeq> & operator=(DataBase<TSeq> && db) = default;
 
     /**
      * @brief Registering a new variant
@@ -249,6 +362,24 @@ public:
         std::string fn_reproductive_number,
         std::string fn_generation_time
         ) const;
+
+    /**
+     * @brief Writes the data in binary columnar format (see `BinaryTable`)
+     * 
+     * @details Same columns as `write_data()` (without the thread id.)
+     * Columns with state names, virus names, or tool names store integer
+     * ids and carry the names as labels. Empty file names are skipped.
+     * The tables can be read back with `BinaryTable::read()`.
+     */
+    void write_data_binary(
+        std::string fn_virus_hist,
+        std::string fn_tool_hist,
+        std::string fn_total_hist,
+        std::string fn_transmission,
+        std::string fn_transition,
+        std::string fn_reproductive_number,
+        std::string fn_generation_time
+        ) const;
     
     /***
      * @brief Record a transmission event
@@ -261,6 +392,47 @@ public:
      */
     void record_transmission(int i, int j, int virus, int i_expo_date);
 
+    /**
+     * @name Streaming of the transmission records
+     * 
+     * @details By default, transmissions are kept in memory for the whole
+     * run. In streaming mode, they are buffered in chunks of `chunk_size`
+     * records, and each full chunk is either appended to the file `fn` or
+     * passed to `fun`. The remaining records are flushed at the end of
+     * `Model::run()`.
+     * 
+     * The file is truncated at the first flush of each run. Each record is
+     * stored as five little-endian 32-bit integers: date, source, target,
+     * virus, and source exposure date. `get_transmissions()`,
+     * `reproductive_number()`, `generation_time()`, and the writers read the
+     * file back one chunk at a time when called (the database itself keeps
+     * only the current chunk); records passed to a callback cannot be
+     * recovered, so these functions throw a `std::logic_error` in that case.
+     * 
+     * Copies of the database (e.g., those made by `Model::run_multiple()`)
+     * keep streaming with the same chunk size. Callbacks are shared by all
+     * copies; the calls are serialized, so a callback is never run by two
+     * copies at once (e.g., by the threads of `run_multiple()`), but the
+     * chunks of different copies may interleave. With a file, each copy
+     * (including those made by assignment) writes to `fn` followed by `.k`,
+     * where `k` is a number unique among the copies; records the original
+     * had already spilled are copied to that file. The copy removes its file
+     * when destroyed or when `transmission_stream_off()` is called. Moving a
+     * database keeps the file.
+     * 
+     * @param chunk_size Number of records per chunk (must be positive.)
+     * @param fn File where to append the chunks.
+     * @param fun Function receiving the columns of each chunk.
+     */
+    ///@{
+    void transmission_stream_on(size_t chunk_size, std::string fn);
+    void transmission_stream_on(size_t chunk_size, TransmissionSink fun);
+    void transmission_stream_off(); ///< Reads spilled records back into memory.
+    bool is_transmission_stream_on() const;
+    void transmission_stream_flush(); ///< Spills the buffered records.
+    size_t get_n_transmissions() const; ///< Total number of records (spilled included.)
+    ///@}
+
     size_t get_n_viruses() const; ///< Get the number of viruses
     size_t get_n_tools() const; ///< Get the number of tools
     
@@ -283,6 +455,11 @@ public:
      * - Virus id
      * - Source id
      * - Date when the source was infected
+     * 
+     * The columnar version (vectors `virus`, `source`,
+     * `source_exposure_date`, and `rt`) groups the transmissions by sorting
+     * them (no map is built,) and returns the cases sorted by virus, source,
+     * and date.
      */
     ///@{
     MapVec_type<int,int> reproductive_number() const;
@@ -290,8 +467,33 @@ public:
     void reproductive_number(
         std::string fn
         ) const;
+
+    void reproductive_number(
+        std::vector< int > & virus,
+        std::vector< int > & source,
+        std::vector< int > & source_exposure_date,
+        std::vector< int > & rt
+        ) const;
     ///@}
 
+    /**
+     * @brief Average reproductive number by date of infection
+     * 
+     * @details For each virus and date, the average number of secondary
+     * cases of the agents infected that day (`rt`,) and the number of
+     * such agents (`n`.) Only the pseudo-source -1 (which groups the
+     * viruses assigned at the beginning of the simulation) is dropped;
+     * agents infected at the beginning are included as sources.
+     * 
+     * @param virus,date,rt,n Vectors where to save the results.
+     */
+    void reproductive_number_by_date(
+        std::vector< int > & virus,
+        std::vector< int > & date,
+        std::vector< epiworld_double > & rt,
+        std::vector< int > & n
+        ) const;
+
     /**
      * @brief Calculates the transition probabilities
      * @param print Print the transition matrix.
@@ -319,7 +521,8 @@ public:
      * 
      * @details
      * The generation time is the time between the infection of the source and 
-     * the infection of the target.
+     * the infection of the target. It is tracked as transmissions are
+     * recorded, so retrieving it takes linear time.
     */
    ///@{
     void generation_time(
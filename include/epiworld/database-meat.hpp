@@ -52,11 +52,19 @@ inline void DataBase<TSeq>::reset()
     hist_total_counts.clear();
     hist_transition_matrix.clear();
 
+    // Only the agents with transmissions can have pending ones
+    for (auto t : transmission_target)
+        if ((t >= 0) && (static_cast< size_t >(t) < gentime_pending_head.size()))
+            gentime_pending_head[t] = -1;
+
     transmission_date.clear();
     transmission_virus.clear();
     transmission_source.clear();
     transmission_target.clear();
     transmission_source_exposure_date.clear();
+    transmission_gentime.clear();
+    gentime_pending_next.clear();
+    transmission_n_flushed = 0u;
 
     return;
 
@@ -106,14 +114,86 @@ inline DataBase<TSeq>::DataBase(const DataBase<TSeq> & db) :
     transmission_target(db.transmission_target),
     transmission_virus(db.transmission_virus),
     transmission_source_exposure_date(db.transmission_source_exposure_date),
+    transmission_gentime(db.transmission_gentime),
+    gentime_pending_head(db.gentime_pending_head),
+    gentime_pending_next(db.gentime_pending_next),
+    transmission_chunk_size(db.transmission_chunk_size),
+    transmission_stream_fn(db.transmission_stream_fn),
+    transmission_stream_fun(db.transmission_stream_fun),
+    transmission_n_flushed(db.transmission_n_flushed),
+    transmission_stream_ncopies(db.transmission_stream_ncopies),
+    transmission_stream_mutex(db.transmission_stream_mutex),
     transition_matrix(db.transition_matrix),
     user_data(nullptr)
-{}
+{
+
+    if (transmission_stream_fn == "")
+        return;
+
+    // Each copy streams to its own file, starting with the records the
+    // original had already spilled
+    transmission_stream_fn += "." + std::to_string(
+        ++(*transmission_stream_ncopies)
+    );
+    transmission_stream_copy.own(transmission_stream_fn);
+
+    if (transmission_n_flushed == 0u)
+        return;
+
+    std::ifstream file_in(
+        db.transmission_stream_fn,
+        std::ios_base::in | std::ios_base::binary
+    );
+
+    std::ofstream file_out(
+        transmission_stream_fn,
+        std::ios_base::out | std::ios_base::trunc | std::ios_base::binary
+    );
+
+    if (!file_in || !file_out)
+        throw std::runtime_error(
+            "Could not copy the transmissions in \"" +
+            db.transmission_stream_fn + "\" to \"" +
+            transmission_stream_fn + "\"."
+        );
 
-// DataBase<TSeq> & DataBase<TSeq>::operator=(const DataBase<TSeq> & m)
-// {
+    std::vector< char > buffer(
+        std::max(transmission_chunk_size, static_cast< size_t >(1u)) * 20u
+    );
 
-// }
+    size_t nleft = transmission_n_flushed * 20u;
+    while (nleft > 0u)
+    {
+
+        size_t nbytes = std::min(nleft, buffer.size());
+        file_in.read(buffer.data(), static_cast< std::streamsize >(nbytes));
+        file_out.write(buffer.data(), static_cast< std::streamsize >(nbytes));
+
+        if (!file_in || !file_out)
+            throw std::runtime_error(
+                "Could not copy the transmissions in \"" +
+                db.transmission_stream_fn + "\" to \"" +
+                transmission_stream_fn + "\"."
+            );
+
+        nleft -= nbytes;
+
+    }
+
+}
+
+template<typename TSeq>
+inline DataBase<TSeq> & DataBase<TSeq>::operator=(const DataBase<TSeq> & db)
+{
+
+    // Same ownership as the copy constructor: the file (if any) of this
+    // database is removed and the copy streams to a new one
+    if (this != &db)
+        *this = DataBase<TSeq>(db);
+
+    return *this;
+
+}
 
 template<typename TSeq>
 inline Model<TSeq> * DataBase<TSeq>::get_model() {
@@ -803,7 +883,7 @@ inline void DataBase<TSeq>::get_transmissions(
 ) const 
 {
 
-    size_t nevents = transmission_date.size();
+    size_t nevents = get_n_transmissions();
 
     date.resize(nevents);
     source.resize(nevents);
@@ -811,6 +891,9 @@ inline void DataBase<TSeq>::get_transmissions(
     virus.resize(nevents);
     source_exposure_date.resize(nevents);
 
+    if (nevents == 0u)
+        return;
+
     get_transmissions(
         &date[0u],
         &source[0u],
@@ -831,18 +914,20 @@ inline void DataBase<TSeq>::get_transmissions(
 ) const 
 {
 
-    size_t nevents = transmission_date.size();
+    size_t offset = 0u;
+    transmission_stream_read([&](
+        const int * date_k, const int * source_k, const int * target_k,
+        const int * virus_k, const int * expo_k, size_t n
+    ) -> void {
 
-    for (size_t i = 0u; i < nevents; ++i)
-    {
+        std::copy(date_k, date_k + n, date + offset);
+        std::copy(source_k, source_k + n, source + offset);
+        std::copy(target_k, target_k + n, target + offset);
+        std::copy(virus_k, virus_k + n, virus + offset);
+        std::copy(expo_k, expo_k + n, source_exposure_date + offset);
+        offset += n;
 
-        *(date + i) = transmission_date.at(i);
-        *(source + i) = transmission_source.at(i);
-        *(target + i) = transmission_target.at(i);
-        *(virus + i) = transmission_virus.at(i);
-        *(source_exposure_date + i) = transmission_source_exposure_date.at(i);
-
-    }
+    });
 
 }
 
@@ -1025,6 +1110,7 @@ inline void DataBase<TSeq>::write_data(
 
     if (fn_transmission != "")
     {
+
         std::ofstream file_transmission(fn_transmission, std::ios_base::out);
 
         // Repeat the same error if the file doesn't exists
@@ -1042,17 +1128,24 @@ inline void DataBase<TSeq>::write_data(
             #endif
             "date " << "virus_id virus " << "source_exposure_date " << "source " << "target\n";
 
-        for (epiworld_fast_uint i = 0; i < transmission_target.size(); ++i)
-            file_transmission <<
-                #ifdef EPI_DEBUG
-                EPI_GET_THREAD_ID() << " " <<
-                #endif
-                transmission_date[i] << " " <<
-                transmission_virus[i] << " \"" <<
-                virus_name[transmission_virus[i]] << "\" " <<
-                transmission_source_exposure_date[i] << " " <<
-                transmission_source[i] << " " <<
-                transmission_target[i] << "\n";
+        transmission_stream_read([&](
+            const int * date, const int * source, const int * target,
+            const int * virus, const int * expo, size_t n
+        ) -> void {
+
+            for (size_t i = 0u; i < n; ++i)
+                file_transmission <<
+                    #ifdef EPI_DEBUG
+                    EPI_GET_THREAD_ID() << " " <<
+                    #endif
+                    date[i] << " " <<
+                    virus[i] << " \"" <<
+                    virus_name[virus[i]] << "\" " <<
+                    expo[i] << " " <<
+                    source[i] << " " <<
+                    target[i] << "\n";
+
+        });
                 
     }
 
@@ -1107,6 +1200,153 @@ inline void DataBase<TSeq>::write_data(
 
 }
 
+template<typename TSeq>
+inline void DataBase<TSeq>::write_data_binary(
+    std::string fn_virus_hist,
+    std::string fn_tool_hist,
+    std::string fn_total_hist,
+    std::string fn_transmission,
+    std::string fn_transition,
+    std::string fn_reproductive_number,
+    std::string fn_generation_time
+) const
+{
+
+    const auto & states = model->states_labels;
+
+    auto as_int = [](const std::vector< epiworld_fast_uint > & x) {
+        return std::vector< int >(x.begin(), x.end());
+    };
+
+    if (fn_virus_hist != "")
+    {
+
+        BinaryTable table;
+        table.
+            add_column("date", hist_virus_date).
+            add_column("virus_id", hist_virus_id, virus_name).
+            add_column("state", as_int(hist_virus_state), states).
+            add_column("n", hist_virus_counts).
+            write(fn_virus_hist);
+
+    }
+
+    if (fn_tool_hist != "")
+    {
+
+        BinaryTable table;
+        table.
+            add_column("date", hist_tool_date).
+            add_column("id", hist_tool_id, tool_name).
+            add_column("state", as_int(hist_tool_state), states).
+            add_column("n", hist_tool_counts).
+            write(fn_tool_hist);
+
+    }
+
+    if (fn_total_hist != "")
+    {
+
+        BinaryTable table;
+        table.
+            add_column("date", hist_total_date).
+            add_column("nviruses", hist_total_nviruses_active).
+            add_column("state", as_int(hist_total_state), states).
+            add_column("counts", hist_total_counts).
+            write(fn_total_hist);
+
+    }
+
+    if (fn_transmission != "")
+    {
+
+        // The table is written at once, so the records are collected
+        // (spilled ones included) in local columns
+        std::vector< int > date, source, target, virus, expo;
+        get_transmissions(date, source, target, virus, expo);
+
+        BinaryTable table;
+        table.
+            add_column("date", date).
+            add_column("virus_id", virus, virus_name).
+            add_column("source_exposure_date", expo).
+            add_column("source", source).
+            add_column("target", target).
+            write(fn_transmission);
+
+    }
+
+    if (fn_transition != "")
+    {
+
+        // Same rows as in write_data() (days without transitions skipped)
+        std::vector< int > date, from, to, counts;
+
+        int ns = model->nstates;
+
+        for (int i = 0; i <= model->today(); ++i)
+        {
+
+            if (hist_transition_matrix[i * (ns * ns)] == 0)
+                continue;
+
+            for (int s_from = 0u; s_from < ns; ++s_from)
+                for (int s_to = 0u; s_to < ns; ++s_to)
+                {
+                    date.push_back(i);
+                    from.push_back(s_from);
+                    to.push_back(s_to);
+                    counts.push_back(
+                        hist_transition_matrix[i * (ns * ns) + s_to * ns + s_from]
+                    );
+                }
+
+        }
+
+        BinaryTable table;
+        table.
+            add_column("date", date).
+            add_column("from", from, states).
+            add_column("to", to, states).
+            add_column("counts", counts).
+            write(fn_transition);
+
+    }
+
+    if (fn_reproductive_number != "")
+    {
+
+        std::vector< int > virus, source, source_exposure_date, rt;
+        reproductive_number(virus, source, source_exposure_date, rt);
+
+        BinaryTable table;
+        table.
+            add_column("virus_id", virus, virus_name).
+            add_column("source", source).
+            add_column("source_exposure_date", source_exposure_date).
+            add_column("rt", rt).
+            write(fn_reproductive_number);
+
+    }
+
+    if (fn_generation_time != "")
+    {
+
+        std::vector< int > agent_id, virus_id, time, gentime;
+        generation_time(agent_id, virus_id, time, gentime);
+
+        BinaryTable table;
+        table.
+            add_column("virus", virus_id, virus_name).
+            add_column("source", agent_id).
+            add_column("source_exposure_date", time).
+            add_column("gentime", gentime).
+            write(fn_generation_time);
+
+    }
+
+}
+
 template<typename TSeq>
 inline void DataBase<TSeq>::record_transmission(
     int i,
@@ -1115,12 +1355,314 @@ inline void DataBase<TSeq>::record_transmission(
     int i_expo_date
 ) {
 
+    int k = static_cast< int >(transmission_date.size());
+
     transmission_date.push_back(model->today());
     transmission_source.push_back(i);
     transmission_target.push_back(j);
     transmission_virus.push_back(virus);
     transmission_source_exposure_date.push_back(i_expo_date);
 
+    // Generation times are computed from the full log when streaming
+    if (transmission_chunk_size > 0u)
+    {
+
+        if (transmission_date.size() >= transmission_chunk_size)
+            transmission_stream_flush();
+
+        return;
+
+    }
+
+    transmission_gentime.push_back(-1);
+    gentime_pending_next.push_back(-1);
+
+    // The target waits for its first onward transmission
+    if (j >= 0)
+    {
+
+        if (static_cast< size_t >(j) >= gentime_pending_head.size())
+            gentime_pending_head.resize(j + 1, -1);
+
+        gentime_pending_next[k] = gentime_pending_head[j];
+        gentime_pending_head[j] = k;
+
+    }
+
+    // This is the first onward transmission of the source, resolving the
+    // transmissions it received
+    if ((i >= 0) && (static_cast< size_t >(i) < gentime_pending_head.size()))
+    {
+
+        int m = gentime_pending_head[i];
+        while (m != -1)
+        {
+            transmission_gentime[m] = transmission_date[k] - transmission_date[m];
+            m = gentime_pending_next[m];
+        }
+
+        gentime_pending_head[i] = -1;
+
+    }
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::transmission_stream_on(
+    size_t chunk_size,
+    std::string fn
+) {
+
+    if (chunk_size == 0u)
+        throw std::invalid_argument("The chunk size must be positive.");
+
+    if (fn == "")
+        throw std::invalid_argument("The file name cannot be empty.");
+
+    transmission_stream_off();
+
+    transmission_chunk_size = chunk_size;
+    transmission_stream_fn  = fn;
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::transmission_stream_on(
+    size_t chunk_size,
+    TransmissionSink fun
+) {
+
+    if (chunk_size == 0u)
+        throw std::invalid_argument("The chunk size must be positive.");
+
+    if (!fun)
+        throw std::invalid_argument("The sink function cannot be empty.");
+
+    transmission_stream_off();
+
+    transmission_chunk_size = chunk_size;
+    transmission_stream_fun = fun;
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::transmission_stream_off()
+{
+
+    // Records sent to a callback are gone
+    if (transmission_stream_fn != "")
+        transmission_stream_load();
+
+    transmission_stream_copy.release();
+
+    transmission_chunk_size = 0u;
+    transmission_stream_fn  = "";
+    transmission_stream_fun = nullptr;
+
+}
+
+template<typename TSeq>
+inline bool DataBase<TSeq>::is_transmission_stream_on() const
+{
+    return transmission_chunk_size > 0u;
+}
+
+template<typename TSeq>
+inline size_t DataBase<TSeq>::get_n_transmissions() const
+{
+    return transmission_n_flushed + transmission_date.size();
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::transmission_stream_flush()
+{
+
+    if (!is_transmission_stream_on())
+        throw std::logic_error("The transmission stream is off.");
+
+    size_t n = transmission_date.size();
+    if (n == 0u)
+        return;
+
+    if (transmission_stream_fun)
+    {
+
+        std::lock_guard< std::mutex > lock(*transmission_stream_mutex);
+        transmission_stream_fun(
+            transmission_date,
+            transmission_source,
+            transmission_target,
+            transmission_virus,
+            transmission_source_exposure_date
+        );
+
+    }
+    else
+    {
+
+        // The first chunk of the run starts a new file
+        std::ofstream file(
+            transmission_stream_fn,
+            std::ios_base::binary | (transmission_n_flushed == 0u ?
+                (std::ios_base::out | std::ios_base::trunc) :
+                (std::ios_base::out | std::ios_base::app))
+        );
+
+        if (!file)
+            throw std::runtime_error(
+                "Could not open file \"" + transmission_stream_fn +
+                "\" for writing."
+            );
+
+        std::vector< unsigned char > buffer(n * 20u);
+        size_t pos = 0u;
+        auto put = [&buffer, &pos](int x) -> void {
+            uint32_t u = static_cast< uint32_t >(static_cast< int32_t >(x));
+            for (size_t b = 0u; b < 4u; ++b)
+                buffer[pos++] = static_cast< unsigned char >(u >> (8u * b));
+        };
+
+        for (size_t i = 0u; i < n; ++i)
+        {
+            put(transmission_date[i]);
+            put(transmission_source[i]);
+            put(transmission_target[i]);
+            put(transmission_virus[i]);
+            put(transmission_source_exposure_date[i]);
+        }
+
+        file.write(
+            reinterpret_cast< const char * >(buffer.data()),
+            static_cast< std::streamsize >(buffer.size())
+        );
+
+        if (!file)
+            throw std::runtime_error(
+                "Error while writing to \"" + transmission_stream_fn + "\"."
+            );
+
+    }
+
+    transmission_n_flushed += n;
+
+    transmission_date.clear();
+    transmission_source.clear();
+    transmission_target.clear();
+    transmission_virus.clear();
+    transmission_source_exposure_date.clear();
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::transmission_stream_load()
+{
+
+    if (transmission_n_flushed == 0u)
+        return;
+
+    std::vector< int > date, source, target, virus, expo;
+    get_transmissions(date, source, target, virus, expo);
+
+    transmission_date.swap(date);
+    transmission_source.swap(source);
+    transmission_target.swap(target);
+    transmission_virus.swap(virus);
+    transmission_source_exposure_date.swap(expo);
+
+    // The next flush rewrites the file from the start
+    transmission_n_flushed = 0u;
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::transmission_stream_read(
+    std::function<void(
+        const int *, const int *, const int *, const int *, const int *,
+        size_t
+    )> fun
+) const
+{
+
+    if (transmission_n_flushed > 0u)
+    {
+
+        if (transmission_stream_fn == "")
+            throw std::logic_error(
+                "The transmissions were passed to the stream function and "
+                "cannot be retrieved."
+            );
+
+        std::ifstream file(
+            transmission_stream_fn,
+            std::ios_base::in | std::ios_base::binary
+        );
+
+        if (!file)
+            throw std::runtime_error(
+                "Could not open file \"" + transmission_stream_fn +
+                "\" for reading."
+            );
+
+        // Spilled records go first, one chunk at a time
+        size_t chunk = std::max(transmission_chunk_size, static_cast< size_t >(1u));
+        std::vector< unsigned char > buffer(chunk * 20u);
+        std::vector< int > date(chunk), source(chunk), target(chunk),
+            virus(chunk), expo(chunk);
+
+        size_t nleft = transmission_n_flushed;
+        while (nleft > 0u)
+        {
+
+            size_t n = std::min(nleft, chunk);
+            file.read(
+                reinterpret_cast< char * >(buffer.data()),
+                static_cast< std::streamsize >(n * 20u)
+            );
+
+            if (static_cast< size_t >(file.gcount()) != (n * 20u))
+                throw std::runtime_error(
+                    "The file \"" + transmission_stream_fn + "\" should have " +
+                    std::to_string(transmission_n_flushed) + " transmissions."
+                );
+
+            size_t pos = 0u;
+            auto get = [&buffer, &pos]() -> int {
+                uint32_t u = 0u;
+                for (size_t b = 0u; b < 4u; ++b)
+                    u |= static_cast< uint32_t >(buffer[pos++]) << (8u * b);
+                return static_cast< int >(static_cast< int32_t >(u));
+            };
+
+            for (size_t i = 0u; i < n; ++i)
+            {
+                date[i]   = get();
+                source[i] = get();
+                target[i] = get();
+                virus[i]  = get();
+                expo[i]   = get();
+            }
+
+            fun(
+                date.data(), source.data(), target.data(), virus.data(),
+                expo.data(), n
+            );
+
+            nleft -= n;
+
+        }
+
+    }
+
+    if (transmission_date.size() > 0u)
+        fun(
+            transmission_date.data(),
+            transmission_source.data(),
+            transmission_target.data(),
+            transmission_virus.data(),
+            transmission_source_exposure_date.data(),
+            transmission_date.size()
+        );
+
 }
 
 template<typename TSeq>
@@ -1173,39 +1715,100 @@ inline UserData<TSeq> & DataBase<TSeq>::get_user_data()
 }
 
 template<typename TSeq>
-inline MapVec_type<int,int> DataBase<TSeq>::reproductive_number()
-const {
+inline void DataBase<TSeq>::reproductive_number(
+    std::vector< int > & virus,
+    std::vector< int > & source,
+    std::vector< int > & source_exposure_date,
+    std::vector< int > & rt
+) const {
 
-    // Checking size
-    MapVec_type<int,int> map;
+    virus.clear();
+    source.clear();
+    source_exposure_date.clear();
+    rt.clear();
+
+    // Each transmission adds two records: one for the source (a secondary
+    // case) and one for the target (a new case with zero secondary cases.)
+    // Sorting by (virus, agent, date, order) groups the records of each
+    // case, in the order in which they happened.
+    struct Record {
+        int virus;
+        int agent;
+        int date;
+        int order; // 2 * transmission + (1 if source)
+    };
+
+    std::vector< Record > records;
+    records.reserve(2u * get_n_transmissions());
+    transmission_stream_read([&records](
+        const int * date, const int * source, const int * target,
+        const int * virus, const int * expo, size_t n
+    ) -> void {
+
+        for (size_t i = 0u; i < n; ++i)
+        {
 
-    // Number of digits of maxid
-    for (size_t i = 0u; i < transmission_date.size(); ++i)
+            int order = static_cast< int >(records.size());
+            records.push_back({virus[i], target[i], date[i], order});
+            records.push_back({virus[i], source[i], expo[i], order + 1});
+
+        }
+
+    });
+
+    std::sort(
+        records.begin(), records.end(),
+        [](const Record & a, const Record & b) {
+            if (a.virus != b.virus)
+                return a.virus < b.virus;
+            if (a.agent != b.agent)
+                return a.agent < b.agent;
+            if (a.date != b.date)
+                return a.date < b.date;
+            return a.order < b.order;
+        });
+
+    for (size_t i = 0u; i < records.size(); ++i)
     {
-        // Fabricating id
-        std::vector< int > h = {
-            transmission_virus[i],
-            transmission_source[i],
-            transmission_source_exposure_date[i]
-        };
 
-        // Adding to counter
-        if (map.find(h) == map.end())
-            map[h] = 1;
-        else
-            map[h]++;
+        const Record & r = records[i];
 
-        // The target is added
-        std::vector< int > h_target = {
-            transmission_virus[i],
-            transmission_target[i],
-            transmission_date[i]
-        };
+        bool new_case = (i == 0u) ||
+            (r.virus != records[i - 1u].virus) ||
+            (r.agent != records[i - 1u].agent) ||
+            (r.date != records[i - 1u].date);
+
+        if (new_case)
+        {
+            virus.push_back(r.virus);
+            source.push_back(r.agent);
+            source_exposure_date.push_back(r.date);
+            rt.push_back(0);
+        }
+
+        // Becoming a case (again) resets the count
+        if (r.order % 2 == 1)
+            rt.back()++;
+        else
+            rt.back() = 0;
 
-        map[h_target] = 0;
-        
     }
 
+    return;
+
+}
+
+template<typename TSeq>
+inline MapVec_type<int,int> DataBase<TSeq>::reproductive_number()
+const {
+
+    std::vector< int > virus, source, source_exposure_date, rt;
+    reproductive_number(virus, source, source_exposure_date, rt);
+
+    MapVec_type<int,int> map;
+    for (size_t i = 0u; i < rt.size(); ++i)
+        map[{virus[i], source[i], source_exposure_date[i]}] = rt[i];
+
     return map;
 
 }
@@ -1215,8 +1818,8 @@ inline void DataBase<TSeq>::reproductive_number(
     std::string fn
 ) const {
 
-
-    auto map = reproductive_number();
+    std::vector< int > virus, source, source_exposure_date, rt;
+    reproductive_number(virus, source, source_exposure_date, rt);
 
     std::ofstream fn_file(fn, std::ios_base::out);
 
@@ -1236,16 +1839,95 @@ inline void DataBase<TSeq>::reproductive_number(
         "virus_id virus source source_exposure_date rt\n";
 
 
-    for (auto & m : map)
+    for (size_t i = 0u; i < rt.size(); ++i)
         fn_file <<
             #ifdef EPI_DEBUG
             EPI_GET_THREAD_ID() << " " <<
             #endif
-            m.first[0u] << " \"" <<
-            virus_name[m.first[0u]] << "\" " <<
-            m.first[1u] << " " <<
-            m.first[2u] << " " <<
-            m.second << "\n";
+            virus[i] << " \"" <<
+            virus_name[virus[i]] << "\" " <<
+            source[i] << " " <<
+            source_exposure_date[i] << " " <<
+            rt[i] << "\n";
+
+    return;
+
+}
+
+template<typename TSeq>
+inline void DataBase<TSeq>::reproductive_number_by_date(
+    std::vector< int > & virus,
+    std::vector< int > & date,
+    std::vector< epiworld_double > & rt,
+    std::vector< int > & n
+) const {
+
+    virus.clear();
+    date.clear();
+    rt.clear();
+    n.clear();
+
+    std::vector< int > case_virus, case_source, case_date, case_rt;
+    reproductive_number(case_virus, case_source, case_date, case_rt);
+
+    if (case_rt.size() == 0u)
+        return;
+
+    // Dense (virus x date) grid
+    int date_min = std::numeric_limits< int >::max();
+    int date_max = std::numeric_limits< int >::min();
+    int virus_max = 0;
+    for (size_t i = 0u; i < case_rt.size(); ++i)
+    {
+
+        if (case_source[i] < 0)
+            continue;
+
+        date_min  = std::min(date_min, case_date[i]);
+        date_max  = std::max(date_max, case_date[i]);
+        virus_max = std::max(virus_max, case_virus[i]);
+
+    }
+
+    if (date_max < date_min)
+        return;
+
+    size_t ndates = static_cast< size_t >(date_max - date_min + 1);
+    size_t nvirus = static_cast< size_t >(virus_max + 1);
+    std::vector< int > sums(ndates * nvirus, 0);
+    std::vector< int > counts(ndates * nvirus, 0);
+
+    for (size_t i = 0u; i < case_rt.size(); ++i)
+    {
+
+        if (case_source[i] < 0)
+            continue;
+
+        size_t loc = static_cast< size_t >(case_virus[i]) * ndates +
+            static_cast< size_t >(case_date[i] - date_min);
+
+        sums[loc] += case_rt[i];
+        counts[loc]++;
+
+    }
+
+    for (size_t v = 0u; v < nvirus; ++v)
+        for (size_t d = 0u; d < ndates; ++d)
+        {
+
+            size_t loc = v * ndates + d;
+            if (counts[loc] == 0)
+                continue;
+
+            virus.push_back(static_cast< int >(v));
+            date.push_back(static_cast< int >(d) + date_min);
+            rt.push_back(
+                static_cast< epiworld_double >(sums[loc]) /
+                static_cast< epiworld_double >(counts[loc])
+            );
+            n.push_back(counts[loc]);
+
+        }
 
     return;
 
@@ -1367,6 +2049,7 @@ inline std::vector< epiworld_double > DataBase<TSeq>::transition_probability(
 template<>
 inline bool DataBase<std::vector<int>>::operator==(const DataBase<std::vector<int>> & other) const
 {
+
     VECT_MATCH(
         virus_name, other.virus_name,
         "DataBase:: virus_name don't match"
@@ -1540,34 +2223,39 @@ inline bool DataBase<std::vector<int>>::operator==(const DataBase<std::vector<in
         "DataBase:: today_total_nviruses_active don't match."
         )
 
-    // Transmission network
+    // Transmission network (spilled records included)
+    std::vector< int > t_date, t_source, t_target, t_virus, t_source_exposure_date;
+    std::vector< int > o_date, o_source, o_target, o_virus, o_source_exposure_date;
+    get_transmissions(t_date, t_source, t_target, t_virus, t_source_exposure_date);
+    other.get_transmissions(o_date, o_source, o_target, o_virus, o_source_exposure_date);
+
     VECT_MATCH(
-        transmission_date,
-        other.transmission_date,                 ///< Date of the transmission eve,
+        t_date,
+        o_date,
         "DataBase:: transmission_date[i] don't match"
         )
 
     VECT_MATCH(
-        transmission_source,
-        other.transmission_source,               ///< Id of the sour,
+        t_source,
+        o_source,
         "DataBase:: transmission_source[i] don't match"
         )
 
     VECT_MATCH(
-        transmission_target,
-        other.transmission_target,               ///< Id of the targ,
+        t_target,
+        o_target,
         "DataBase:: transmission_target[i] don't match"
         )
 
     VECT_MATCH(
-        transmission_virus,
-        other.transmission_virus,              ///< Id of the varia,
+        t_virus,
+        o_virus,
         "DataBase:: transmission_virus[i] don't match"
         )
 
     VECT_MATCH(
-        transmission_source_exposure_date,
-        other.transmission_source_exposure_date, ///< Date when the source acquired the varia,
+        t_source_exposure_date,
+        o_source_exposure_date,
         "DataBase:: transmission_source_exposure_date[i] don't match"
         )
 
@@ -1586,6 +2274,7 @@ inline bool DataBase<std::vector<int>>::operator==(const DataBase<std::vector<in
 template<typename TSeq>
 inline bool DataBase<TSeq>::operator==(const DataBase<TSeq> & other) const
 {
+
     VECT_MATCH(
         virus_name,
         other.virus_name,
@@ -1755,34 +2444,39 @@ inline bool DataBase<TSeq>::operator==(const DataBase<TSeq> & other) const
         "DataBase:: today_total_nviruses_active don't match."
     )
 
-    // Transmission network
+    // Transmission network (spilled records included)
+    std::vector< int > t_date, t_source, t_target, t_virus, t_source_exposure_date;
+    std::vector< int > o_date, o_source, o_target, o_virus, o_source_exposure_date;
+    get_transmissions(t_date, t_source, t_target, t_virus, t_source_exposure_date);
+    other.get_transmissions(o_date, o_source, o_target, o_virus, o_source_exposure_date);
+
     VECT_MATCH( ///< Date of the transmission eve
-        transmission_date,
-        other.transmission_date,
+        t_date,
+        o_date,
         "DataBase:: transmission_date[i] don't match"
     )
 
     VECT_MATCH( ///< Id of the sour
-        transmission_source,
-        other.transmission_source,
+        t_source,
+        o_source,
         "DataBase:: transmission_source[i] don't match"
     )
 
     VECT_MATCH( ///< Id of the targ
-        transmission_target,
-        other.transmission_target,
+        t_target,
+        o_target,
         "DataBase:: transmission_target[i] don't match"
     )
 
     VECT_MATCH( ///< Id of the varia
-        transmission_virus,
-        other.transmission_virus,
+        t_virus,
+        o_virus,
         "DataBase:: transmission_virus[i] don't match"
     )
 
     VECT_MATCH( ///< Date when the source acquired the varia
-        transmission_source_exposure_date,
-        other.transmission_source_exposure_date,
+        t_source_exposure_date,
+        o_source_exposure_date,
         "DataBase:: transmission_source_exposure_date[i] don't match"
     )
 
@@ -1803,39 +2497,76 @@ inline void DataBase<TSeq>::generation_time(
     std::vector< int > & time,
     std::vector< int > & gentime
 ) const {
-    
-    size_t nevents = transmission_date.size();
 
-    agent_id.reserve(nevents);
-    virus_id.reserve(nevents);
-    time.reserve(nevents);
-    gentime.reserve(nevents);
+    size_t nevents = get_n_transmissions();
+    size_t base    = time.size();
+
+    agent_id.reserve(base + nevents);
+    virus_id.reserve(base + nevents);
+    time.reserve(base + nevents);
+    gentime.reserve(base + nevents);
+
+    // Already computed by record_transmission()
+    bool computed = transmission_gentime.size() == nevents;
+    std::vector< int > source;
+    if (!computed)
+        source.reserve(nevents);
+
+    transmission_stream_read([&](
+        const int * date_k, const int * source_k, const int * target_k,
+        const int * virus_k, const int *, size_t n
+    ) -> void {
 
-    // Iterating through the individuals
-    for (size_t i = 0u; i < nevents; ++i)
+        agent_id.insert(agent_id.end(), target_k, target_k + n);
+        virus_id.insert(virus_id.end(), virus_k, virus_k + n);
+        time.insert(time.end(), date_k, date_k + n);
+
+        if (!computed)
+            source.insert(source.end(), source_k, source_k + n);
+
+    });
+
+    if (computed)
     {
-        int agent_id_i = transmission_target[i];
-        agent_id.push_back(agent_id_i);
-        virus_id.push_back(transmission_virus[i]);
-        time.push_back(transmission_date[i]);
 
-        bool found = false;
-        for (size_t j = i; j < nevents; ++j)
+        gentime.insert(
+            gentime.end(),
+            transmission_gentime.begin(),
+            transmission_gentime.end()
+        );
+
+    }
+    else
+    {
+
+        const int * target = agent_id.data() + base;
+        const int * date   = time.data() + base;
+
+        // The generation time of transmission i is given by the first
+        // transmission j >= i with the target of i as source. Going
+        // backwards, next_source[a] holds the first such j for agent a.
+        int max_id = -1;
+        for (size_t i = 0u; i < nevents; ++i)
+            max_id = std::max(max_id, std::max(source[i], target[i]));
+
+        std::vector< int > next_source(max_id + 1, -1);
+        std::vector< int > gentime_i(nevents, -1);
+        for (size_t i = nevents; i-- > 0u;)
         {
 
-            if (transmission_source[j] == agent_id_i)
-            {
-                gentime.push_back(transmission_date[j] - time[i]);
-                found = true;
-                break;
-            }
+            if (source[i] >= 0)
+                next_source[source[i]] = static_cast< int >(i);
+
+            int j = target[i] >= 0 ? next_source[target[i]] : -1;
+
+            // If there's no transmission, we set the generation time to
+            // minus 1;
+            if (j != -1)
+                gentime_i[i] = date[j] - date[i];
 
         }
 
-        // If there's no transmission, we set the generation time to
-        // minus 1;
-        if (!found)
-            gentime.push_back(-1);
+        gentime.insert(gentime.end(), gentime_i.begin(), gentime_i.end());
 
     }
 
@@ -17,6 +17,14 @@
 #include <set>
 #include <type_traits>
 #include <cassert>
+#include <iterator>
+#include <mutex>
+#include <cstring>
+#include <numeric>
+#include <cmath>
+#include <list>
+#include <atomic>
+#include <cstdio>
 
 #ifndef EPIWORLD_HPP
 #define EPIWORLD_HPP
@@ -37,13 +45,18 @@ namespace epiworld {
 
     #include "misc.hpp"
     #include "progress.hpp"
+    #include "filebytes.hpp"
+    #include "binarytable.hpp"
 
     #include "modeldiagram-bones.hpp"
     #include "modeldiagram-meat.hpp"
 
+    #include "random_philox.hpp"
+
     #include "math/distributions.hpp"
 
     #include "math/lfmcmc.hpp"
+    #include "math/abcsmc.hpp"
 
     #include "userdata-bones.hpp"
     #include "userdata-meat.hpp"
@@ -82,6 +95,8 @@ namespace epiworld {
     #include "entity-meat.hpp"
 
     #include "entities-bones.hpp"
+
+    #include "neighbors-bones.hpp"
     
     #include "agent-meat-state.hpp"
     #include "agent-bones.hpp"
@@ -89,6 +104,9 @@ namespace epiworld {
 
     #include "agentssample-bones.hpp"
 
+    #include "resultscollector-bones.hpp"
+    #include "resultscollector-meat.hpp"
+
     #include "models/models.hpp"
 
 }
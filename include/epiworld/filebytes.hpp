@@ -0,0 +1,136 @@
+#ifndef EPIWORLD_FILEBYTES_HPP
+#define EPIWORLD_FILEBYTES_HPP
+
+/**
+ * @brief Loads a whole file into memory.
+ *
+ * @tparam TChar Type of the bytes (`char` or `unsigned char`.)
+ * @param fn Path to the file.
+ * @param padding Number of zero bytes appended after the contents (e.g., so
+ * text parsers can stop at a trailing zero.)
+ * @return The contents of the file followed by `padding` zeros.
+ * @throws std::runtime_error If the file cannot be opened, its size cannot
+ * be determined, or it cannot be read completely.
+ */
+template<typename TChar = char>
+inline std::vector< TChar > read_file_bytes(
+    const std::string & fn,
+    size_t padding = 0u
+)
+{
+
+    std::ifstream file(fn, std::ios_base::in | std::ios_base::binary);
+
+    if (!file)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for reading."
+        );
+
+    file.seekg(0, std::ios_base::end);
+    std::streamoff nbytes = file.tellg();
+    if (nbytes < 0)
+        throw std::runtime_error(
+            "Could not determine the size of \"" + fn + "\"."
+        );
+
+    file.seekg(0, std::ios_base::beg);
+
+    std::vector< TChar > buffer(static_cast< size_t >(nbytes) + padding, 0);
+    file.read(
+        reinterpret_cast< char * >(buffer.data()),
+        static_cast< std::streamsize >(nbytes)
+    );
+
+    if (file.bad() || (file.gcount() != static_cast< std::streamsize >(nbytes)))
+        throw std::runtime_error("Error while reading \"" + fn + "\".");
+
+    return buffer;
+
+}
+
+/**
+ * @brief Reads little-endian integers and strings from a buffer loaded with
+ * `read_file_bytes()`.
+ *
+ * @details Used by the binary readers (`BinaryTable::read()` and
+ * `Model::agents_from_network_snapshot()`.) Reading past the end of the
+ * buffer throws a `std::runtime_error` saying the file is truncated or
+ * corrupted.
+ */
+class ByteReader {
+private:
+
+    const std::vector< unsigned char > & buffer;
+    const std::string & fn;
+    size_t pos = 0u;
+
+public:
+
+    ByteReader(
+        const std::vector< unsigned char > & buffer_,
+        const std::string & fn_
+    ) : buffer(buffer_), fn(fn_) {};
+
+    /**
+     * @brief Throws unless `nitems` items of `size` bytes are left.
+     */
+    void need(size_t nitems, size_t size = 1u) const
+    {
+        if ((size != 0u) && (nitems > (remaining() / size)))
+            error();
+    };
+
+    /**
+     * @brief Reads an unsigned integer of `nbytes` bytes (at most 8.)
+     */
+    uint64_t get(size_t nbytes)
+    {
+        need(nbytes);
+        uint64_t x = 0u;
+        for (size_t b = 0u; b < nbytes; ++b)
+            x |= static_cast< uint64_t >(buffer[pos++]) << (8u * b);
+        return x;
+    };
+
+    /**
+     * @brief Reads a string stored as its length (uint32) followed by the
+     * characters.
+     */
+    std::string get_string()
+    {
+        size_t n = static_cast< size_t >(get(4u));
+        need(n);
+        std::string s(buffer.begin() + pos, buffer.begin() + pos + n);
+        pos += n;
+        return s;
+    };
+
+    /**
+     * @brief Reads as many characters as `magic` has and compares them.
+     */
+    bool check_magic(const std::string & magic)
+    {
+        need(magic.size());
+        std::string s(buffer.begin() + pos, buffer.begin() + pos + magic.size());
+        pos += magic.size();
+        return s == magic;
+    };
+
+    size_t remaining() const noexcept
+    {
+        return buffer.size() - pos;
+    };
+
+    /**
+     * @brief Throws the truncated or corrupted file error.
+     */
+    [[noreturn]] void error() const
+    {
+        throw std::runtime_error(
+            "The file \"" + fn + "\" is truncated or corrupted."
+        );
+    };
+
+};
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef EPIWORLD_ABCSMC_HPP
+#define EPIWORLD_ABCSMC_HPP
+
+#include "abcsmc/abcsmc-bones.hpp"
+#include "abcsmc/abcsmc-meat.hpp"
+
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+#ifndef EPIWORLD_ABCSMC_BONES_HPP
+#define EPIWORLD_ABCSMC_BONES_HPP
+
+template<typename TData>
+class ABCSMC;
+
+/**
+ * @brief Prior sampler
+ * @param params Vector where to save the parameters (to be resized by the
+ * function.)
+ * @param m LFMCMC model (provides the random numbers.)
+ */
+template<typename TData>
+using ABCSMCPriorFun = std::function<void(std::vector< epiworld_double >&,LFMCMC<TData>*)>;
+
+/**
+ * @brief Prior density (up to a constant)
+ */
+template<typename TData>
+using ABCSMCPriorDensityFun = std::function<epiworld_double(const std::vector< epiworld_double >&)>;
+
+/**
+ * @brief Approximate Bayesian Computation Sequential Monte Carlo
+ *
+ * @details Population Monte Carlo sampler (Beaumont et al., 2009). The first
+ * generation draws `n_particles` from the prior. Each following generation
+ * sets epsilon to the `alpha` quantile of the distances of the previous
+ * generation (but not below the target epsilon), and refills the population
+ * by resampling the previous one, perturbing the particles with a normal
+ * kernel (twice the weighted variance), and keeping those with a positive
+ * kernel score. Particles are weighted by
+ * `prior * kernel score / sum_j w_j q(particle | particle_j)`. The sampler
+ * stops once the target epsilon (or the maximum number of generations) is
+ * reached.
+ *
+ * The simulation, summary, and kernel functions have the same signature as
+ * in `LFMCMC`. Proposals are simulated in parallel, each on its own copy of
+ * the `LFMCMC` object (with its own engine seeded from the master), so the
+ * results do not depend on the number of threads.
+ *
+ * @tparam TData Type of data that is generated
+ */
+template<typename TData>
+class ABCSMC {
+private:
+
+    LFMCMC<TData> m_sampler; ///< Holds the data, functions, and engine.
+
+    ABCSMCPriorFun<TData> m_prior_fun;
+    ABCSMCPriorDensityFun<TData> m_prior_density_fun;
+
+    // Information about the size of the process
+    size_t m_n_particles = 0u;
+    size_t m_n_params    = 0u;
+    size_t m_n_stats     = 0u;
+    size_t m_n_simulations = 0u;
+
+    std::vector< epiworld_double > m_particles; ///< Current population (n_particles x n_params)
+    std::vector< epiworld_double > m_stats;     ///< Statistics of the particles (n_particles x n_stats)
+    std::vector< epiworld_double > m_distances; ///< Distance to the observed statistics
+    std::vector< epiworld_double > m_weights;   ///< Normalized weights
+
+    std::vector< epiworld_double > m_epsilons;        ///< Epsilon of each generation
+    std::vector< size_t > m_n_simulations_generation; ///< Simulations of each generation
+
+    bool verbose = true;
+
+    std::chrono::duration<epiworld_double,std::micro> m_elapsed_time =
+        std::chrono::duration<epiworld_double,std::micro>::zero();
+
+    epiworld_double distance(const epiworld_double * stats) const;
+
+    void run_generation(
+        epiworld_double epsilon,
+        std::vector< LFMCMC<TData> > & workers,
+        int nthreads
+    );
+
+public:
+
+    ABCSMC() {};
+    ABCSMC(const TData & observed_data_) : m_sampler(observed_data_) {};
+
+    /**
+     * @brief Runs the sampler
+     *
+     * @param n_particles Number of particles.
+     * @param epsilon_ Target epsilon.
+     * @param n_generations Maximum number of generations (including the one
+     * drawn from the prior.)
+     * @param alpha Quantile of the distances used to set the next epsilon.
+     * @param seed Seed for the master engine.
+     * @param nthreads Number of threads.
+     */
+    void run(
+        size_t n_particles,
+        epiworld_double epsilon_,
+        size_t n_generations,
+        epiworld_double alpha = .5,
+        int seed = -1,
+        int nthreads = 1
+        );
+
+    void set_observed_data(const TData & observed_data_);
+    void set_simulation_fun(LFMCMCSimFun<TData> fun);
+    void set_summary_fun(LFMCMCSummaryFun<TData> fun);
+    void set_kernel_fun(LFMCMCKernelFun<TData> fun);
+    void set_prior(ABCSMCPriorFun<TData> fun, ABCSMCPriorDensityFun<TData> density);
+    void set_prior_uniform(
+        std::vector< epiworld_double > lb,
+        std::vector< epiworld_double > ub
+    );
+
+    void set_rand_engine(std::shared_ptr< std::mt19937 > & eng);
+    void seed(epiworld_fast_uint s);
+
+    size_t get_n_particles() const {return m_n_particles;};
+    size_t get_n_params() const {return m_n_params;};
+    size_t get_n_stats() const {return m_n_stats;};
+    size_t get_n_generations() const {return m_epsilons.size();};
+    size_t get_n_simulations() const {return m_n_simulations;}; ///< Simulations consumed.
+
+    const std::vector< epiworld_double > & get_particles() const {return m_particles;};
+    const std::vector< epiworld_double > & get_stats() const {return m_stats;};
+    const std::vector< epiworld_double > & get_weights() const {return m_weights;};
+    const std::vector< epiworld_double > & get_distances() const {return m_distances;};
+    const std::vector< epiworld_double > & get_epsilons() const {return m_epsilons;};
+    const std::vector< size_t > & get_n_simulations_generation() const {return m_n_simulations_generation;};
+
+    std::vector< epiworld_double > get_mean_params() const; ///< Weighted mean.
+    epiworld_double get_ess() const; ///< Effective sample size of the weights.
+
+    ABCSMC<TData> & verbose_off();
+    ABCSMC<TData> & verbose_on();
+    void print() const;
+
+};
+
+#endif
@@ -0,0 +1,555 @@
+#ifndef EPIWORLD_ABCSMC_MEAT_HPP
+#define EPIWORLD_ABCSMC_MEAT_HPP
+
+#include "abcsmc-bones.hpp"
+
+template<typename TData>
+inline void ABCSMC<TData>::set_observed_data(const TData & observed_data_)
+{
+    m_sampler.set_observed_data(observed_data_);
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_simulation_fun(LFMCMCSimFun<TData> fun)
+{
+    m_sampler.set_simulation_fun(fun);
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_summary_fun(LFMCMCSummaryFun<TData> fun)
+{
+    m_sampler.set_summary_fun(fun);
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_kernel_fun(LFMCMCKernelFun<TData> fun)
+{
+    m_sampler.set_kernel_fun(fun);
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_prior(
+    ABCSMCPriorFun<TData> fun,
+    ABCSMCPriorDensityFun<TData> density
+)
+{
+    m_prior_fun         = fun;
+    m_prior_density_fun = density;
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_prior_uniform(
+    std::vector< epiworld_double > lb,
+    std::vector< epiworld_double > ub
+)
+{
+
+    if (lb.size() != ub.size())
+        throw std::length_error(
+            "The lower and upper bounds must have the same length."
+            );
+
+    for (size_t k = 0u; k < lb.size(); ++k)
+        if (lb[k] >= ub[k])
+            throw std::range_error(
+                "The lower bound of parameter " + std::to_string(k) +
+                " must be less than the upper bound."
+                );
+
+    m_prior_fun = [lb, ub](
+        std::vector< epiworld_double > & params,
+        LFMCMC<TData> * m
+    ) -> void {
+
+        params.resize(lb.size());
+        for (size_t k = 0u; k < lb.size(); ++k)
+            params[k] = m->runif(lb[k], ub[k]);
+
+    };
+
+    m_prior_density_fun = [lb, ub](
+        const std::vector< epiworld_double > & params
+    ) -> epiworld_double {
+
+        for (size_t k = 0u; k < lb.size(); ++k)
+            if ((params[k] < lb[k]) || (params[k] > ub[k]))
+                return 0.0;
+
+        return 1.0;
+
+    };
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::set_rand_engine(std::shared_ptr< std::mt19937 > & eng)
+{
+    m_sampler.set_rand_engine(eng);
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::seed(epiworld_fast_uint s)
+{
+    m_sampler.seed(s);
+}
+
+template<typename TData>
+inline epiworld_double ABCSMC<TData>::distance(
+    const epiworld_double * stats
+) const
+{
+
+    return std::sqrt(
+        sq_dist_euclidean(m_sampler.m_observed_stats.data(), stats, m_n_stats)
+        );
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::run_generation(
+    epiworld_double epsilon,
+    std::vector< LFMCMC<TData> > & workers,
+    int nthreads
+)
+{
+
+    auto & sampler = m_sampler;
+    size_t N  = m_n_particles;
+    size_t np = m_n_params;
+    size_t ns = m_n_stats;
+    bool first = m_epsilons.size() == 0u;
+
+    // Perturbation kernel: normal with twice the weighted variance
+    std::vector< epiworld_double > sd(np, 0.0);
+    std::vector< epiworld_double > cumweights(N, 0.0);
+    if (!first)
+    {
+
+        for (size_t k = 0u; k < np; ++k)
+        {
+
+            epiworld_double mean = 0.0;
+            for (size_t i = 0u; i < N; ++i)
+                mean += m_weights[i] * m_particles[i * np + k];
+
+            epiworld_double var = 0.0;
+            for (size_t i = 0u; i < N; ++i)
+            {
+                epiworld_double d = m_particles[i * np + k] - mean;
+                var += m_weights[i] * d * d;
+            }
+
+            sd[k] = std::sqrt(2.0 * var);
+
+        }
+
+        std::partial_sum(m_weights.begin(), m_weights.end(), cumweights.begin());
+
+    }
+
+    sampler.m_epsilon = epsilon;
+    for (auto & w : workers)
+        w.m_epsilon = epsilon;
+
+    std::vector< epiworld_double > particles(N * np);
+    std::vector< epiworld_double > stats(N * ns);
+    std::vector< epiworld_double > distances(N);
+    std::vector< epiworld_double > scores(N);
+
+    std::vector< std::vector< epiworld_double > > proposed_params(
+        N, std::vector< epiworld_double >(np)
+    );
+    std::vector< std::vector< epiworld_double > > proposed_stats(N);
+    std::vector< epiworld_double > proposed_scores(N);
+
+    size_t n_accepted = 0u;
+    size_t n_sims     = 0u;
+    epiworld_double acceptance = 1.0;
+    while (n_accepted < N)
+    {
+
+        // Simulating more proposals than needed based on the acceptance
+        // rate so far
+        size_t n_needed = N - n_accepted;
+        size_t n_proposals = std::min(N, std::max(
+            n_needed,
+            static_cast< size_t >(std::ceil(n_needed / acceptance))
+        ));
+
+        // Proposals are made by the master (so these don't depend on the
+        // number of threads)
+        for (size_t b = 0u; b < n_proposals; ++b)
+        {
+
+            auto & params = proposed_params[b];
+
+            if (first)
+            {
+                m_prior_fun(params, &sampler);
+                continue;
+            }
+
+            do
+            {
+
+                epiworld_double u = sampler.runif() * cumweights.back();
+                size_t j = static_cast< size_t >(std::upper_bound(
+                    cumweights.begin(), cumweights.end() - 1, u
+                ) - cumweights.begin());
+
+                for (size_t k = 0u; k < np; ++k)
+                    params[k] = m_particles[j * np + k] + sampler.rnorm() * sd[k];
+
+            } while (m_prior_density_fun(params) <= 0.0);
+
+        }
+
+        std::vector< std::exception_ptr > errors(n_proposals, nullptr);
+
+        #if defined(_OPENMP) || defined(__OPENMP)
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+        #else
+        (void) nthreads;
+        #endif
+        for (int b = 0; b < static_cast< int >(n_proposals); ++b)
+        {
+
+            auto & worker = workers[b];
+
+            try
+            {
+
+                worker.m_current_proposed_params = proposed_params[b];
+
+                TData data_b = sampler.m_simulation_fun(proposed_params[b], &worker);
+                sampler.m_summary_fun(proposed_stats[b], data_b, &worker);
+
+                proposed_scores[b] = sampler.m_kernel_fun(
+                    proposed_stats[b], sampler.m_observed_stats, epsilon, &worker
+                );
+
+            }
+            catch (...)
+            {
+                errors[b] = std::current_exception();
+            }
+
+        }
+
+        for (auto & e : errors)
+            if (e)
+                std::rethrow_exception(e);
+
+        n_sims += n_proposals;
+
+        // Keeping the proposals with a positive score (in order)
+        size_t n_accepted_round = 0u;
+        for (size_t b = 0u; (b < n_proposals) && (n_accepted < N); ++b)
+        {
+
+            if (proposed_scores[b] <= 0.0)
+                continue;
+
+            std::copy(
+                proposed_params[b].begin(), proposed_params[b].end(),
+                particles.begin() + n_accepted * np
+            );
+            std::copy(
+                proposed_stats[b].begin(), proposed_stats[b].end(),
+                stats.begin() + n_accepted * ns
+            );
+
+            scores[n_accepted]    = proposed_scores[b];
+            distances[n_accepted] = distance(proposed_stats[b].data());
+
+            ++n_accepted;
+            ++n_accepted_round;
+
+        }
+
+        acceptance = std::max(
+            static_cast< epiworld_double >(n_accepted_round) /
+                static_cast< epiworld_double >(n_proposals),
+            static_cast< epiworld_double >(1.0) /
+                static_cast< epiworld_double >(N)
+        );
+
+    }
+
+    // Importance weights. Particles from the prior are weighted by their
+    // kernel score only.
+    std::vector< epiworld_double > weights(N);
+    for (size_t i = 0u; i < N; ++i)
+    {
+
+        if (first)
+        {
+            weights[i] = scores[i];
+            continue;
+        }
+
+        const epiworld_double * theta = particles.data() + i * np;
+
+        // Normalizing constants of the perturbation kernel cancel out
+        epiworld_double denom = 0.0;
+        for (size_t j = 0u; j < N; ++j)
+        {
+
+            const epiworld_double * theta_j = m_particles.data() + j * np;
+
+            epiworld_double z2 = 0.0;
+            for (size_t k = 0u; k < np; ++k)
+            {
+
+                // Constant parameters are not perturbed
+                if (sd[k] <= 0.0)
+                    continue;
+
+                epiworld_double z = (theta[k] - theta_j[k]) / sd[k];
+                z2 += z * z;
+
+            }
+
+            denom += m_weights[j] * std::exp(-.5 * z2);
+
+        }
+
+        std::vector< epiworld_double > theta_vec(theta, theta + np);
+        weights[i] = m_prior_density_fun(theta_vec) * scores[i] / denom;
+
+    }
+
+    epiworld_double total = std::accumulate(
+        weights.begin(), weights.end(), static_cast< epiworld_double >(0.0)
+    );
+
+    for (auto & w : weights)
+        w /= total;
+
+    m_particles.swap(particles);
+    m_stats.swap(stats);
+    m_distances.swap(distances);
+    m_weights.swap(weights);
+
+    m_epsilons.push_back(epsilon);
+    m_n_simulations_generation.push_back(n_sims);
+    m_n_simulations += n_sims;
+
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::run(
+    size_t n_particles,
+    epiworld_double epsilon_,
+    size_t n_generations,
+    epiworld_double alpha,
+    int seed,
+    int nthreads
+    )
+{
+
+    auto time_start = std::chrono::steady_clock::now();
+
+    if (!m_prior_fun || !m_prior_density_fun)
+        throw std::logic_error(
+            "The prior must be set (see -set_prior()- or -set_prior_uniform()-)."
+            );
+
+    if (n_particles < 2u)
+        throw std::invalid_argument("At least 2 particles are needed.");
+
+    if (n_generations == 0u)
+        throw std::invalid_argument("At least 1 generation is needed.");
+
+    if ((alpha <= 0.0) || (alpha >= 1.0))
+        throw std::range_error("alpha must be in (0, 1).");
+
+    auto & sampler = m_sampler;
+    if (sampler.m_engine == nullptr)
+        sampler.m_engine = std::make_shared< std::mt19937 >();
+
+    if (seed >= 0)
+        sampler.seed(seed);
+
+    m_n_particles = n_particles;
+
+    // Observed statistics
+    sampler.m_summary_fun(sampler.m_observed_stats, sampler.m_observed_data, &sampler);
+    m_n_stats = sampler.m_observed_stats.size();
+
+    // The number of parameters is taken from the prior
+    std::vector< epiworld_double > params_0;
+    m_prior_fun(params_0, &sampler);
+    m_n_params = params_0.size();
+
+    sampler.m_n_params       = m_n_params;
+    sampler.m_n_stats        = m_n_stats;
+    sampler.m_initial_params = params_0;
+    sampler.m_current_proposed_params = params_0;
+    sampler.m_current_accepted_params = params_0;
+
+    // One worker per proposal
+    std::vector< LFMCMC<TData> > workers;
+    workers.reserve(n_particles);
+    for (size_t i = 0u; i < n_particles; ++i)
+        workers.push_back(sampler.make_worker(
+            static_cast< unsigned int >((*sampler.m_engine)())
+        ));
+
+    m_epsilons.clear();
+    m_n_simulations_generation.clear();
+    m_n_simulations = 0u;
+
+    // Generation 0 is drawn from the prior
+    epiworld_double epsilon = std::numeric_limits< epiworld_double >::infinity();
+    for (size_t g = 0u; g < n_generations; ++g)
+    {
+
+        if (g > 0u)
+        {
+
+            // Next epsilon from the distances of the current population
+            std::vector< epiworld_double > d(m_distances);
+            size_t q = static_cast< size_t >(
+                std::floor(alpha * static_cast< epiworld_double >(d.size() - 1u))
+            );
+            std::nth_element(d.begin(), d.begin() + q, d.end());
+
+            epsilon = std::max(d[q], epsilon_);
+
+        }
+
+        run_generation(epsilon, workers, nthreads);
+
+        if (verbose)
+        {
+            printf_epiworld(
+                "Generation %3zu: epsilon = %.4f, simulations = %zu\n",
+                g, static_cast< double >(epsilon), m_n_simulations_generation.back()
+                );
+        }
+
+        if (epsilon <= epsilon_)
+            break;
+
+    }
+
+    m_elapsed_time += (std::chrono::steady_clock::now() - time_start);
+
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > ABCSMC<TData>::get_mean_params() const
+{
+
+    std::vector< epiworld_double > res(m_n_params, 0.0);
+
+    for (size_t i = 0u; i < m_n_particles; ++i)
+        for (size_t k = 0u; k < m_n_params; ++k)
+            res[k] += m_weights[i] * m_particles[i * m_n_params + k];
+
+    return res;
+
+}
+
+template<typename TData>
+inline epiworld_double ABCSMC<TData>::get_ess() const
+{
+
+    epiworld_double ans = 0.0;
+    for (auto & w : m_weights)
+        ans += w * w;
+
+    return 1.0 / ans;
+
+}
+
+template<typename TData>
+inline ABCSMC<TData> & ABCSMC<TData>::verbose_off()
+{
+    verbose = false;
+    return *this;
+}
+
+template<typename TData>
+inline ABCSMC<TData> & ABCSMC<TData>::verbose_on()
+{
+    verbose = true;
+    return *this;
+}
+
+template<typename TData>
+inline void ABCSMC<TData>::print() const
+{
+
+    printf_epiworld("___________________________________________\n\n");
+    printf_epiworld("ABC SEQUENTIAL MONTE CARLO\n\n");
+
+    printf_epiworld("N Particles   : %zu\n", m_n_particles);
+    printf_epiworld("N Generations : %zu\n", m_epsilons.size());
+    printf_epiworld("N Simulations : %zu\n", m_n_simulations);
+    printf_epiworld("ESS (weights) : %.2f\n", static_cast< double >(get_ess()));
+    printf_epiworld(
+        "Elapsed t     : %.2fms\n\n",
+        static_cast< double >(m_elapsed_time.count() / 1000.0)
+        );
+
+    // Weighted mean and 95% credible interval
+    printf_epiworld("Parameters:\n");
+
+    auto means = get_mean_params();
+    std::vector< size_t > idx(m_n_particles);
+    for (size_t k = 0u; k < m_n_params; ++k)
+    {
+
+        std::iota(idx.begin(), idx.end(), 0u);
+        std::sort(idx.begin(), idx.end(), [&](size_t a, size_t b) {
+            return m_particles[a * m_n_params + k] < m_particles[b * m_n_params + k];
+        });
+
+        epiworld_double lower = m_particles[idx.front() * m_n_params + k];
+        epiworld_double upper = m_particles[idx.back() * m_n_params + k];
+        epiworld_double cum   = 0.0;
+        bool lower_set = false;
+        for (auto i : idx)
+        {
+
+            cum += m_weights[i];
+
+            if (!lower_set && (cum >= .025))
+            {
+                lower     = m_particles[i * m_n_params + k];
+                lower_set = true;
+            }
+
+            if (cum >= .975)
+            {
+                upper = m_particles[i * m_n_params + k];
+                break;
+            }
+
+        }
+
+        printf_epiworld(
+            "  [%-2ld]: % .2f [% .2f, % .2f]\n", k,
+            static_cast< double >(means[k]),
+            static_cast< double >(lower),
+            static_cast< double >(upper)
+            );
+
+    }
+
+    printf_epiworld("\nEpsilon by generation:\n");
+    for (size_t g = 0u; g < m_epsilons.size(); ++g)
+    {
+        printf_epiworld(
+            "  [%-2ld]: % .4f (%zu simulations)\n", g,
+            static_cast< double >(m_epsilons[g]), m_n_simulations_generation[g]
+            );
+    }
+
+    printf_epiworld("___________________________________________\n\n");
+
+}
+
+#endif
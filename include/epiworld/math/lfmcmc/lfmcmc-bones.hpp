@@ -9,6 +9,9 @@
 template<typename TData>
 class LFMCMC;
 
+template<typename TData>
+class ABCSMC;
+
 template<typename TData>
 using LFMCMCSimFun = std::function<TData(const std::vector< epiworld_double >&,LFMCMC<TData>*)>;
 
@@ -109,6 +112,73 @@ inline epiworld_double kernel_fun_gaussian(
     LFMCMC<TData>* m
 );
 
+/**
+ * @name Squared distances between statistics
+ * 
+ * @details Operate on contiguous buffers of `n` statistics. The scaled
+ * version multiplies each difference by `inv_scale[k]` (e.g., one over the
+ * median absolute deviation of the statistic, see `LFMCMC::get_stats_mad()`.)
+ * The Mahalanobis version takes the inverse of the lower Cholesky factor of
+ * the covariance matrix (`n x n`, row-major).
+ */
+///@{
+inline epiworld_double sq_dist_euclidean(
+    const epiworld_double * x,
+    const epiworld_double * y,
+    size_t n
+);
+
+inline epiworld_double sq_dist_scaled(
+    const epiworld_double * x,
+    const epiworld_double * y,
+    const epiworld_double * inv_scale,
+    size_t n
+);
+
+inline epiworld_double sq_dist_mahalanobis(
+    const epiworld_double * x,
+    const epiworld_double * y,
+    const epiworld_double * inv_chol,
+    size_t n
+);
+///@}
+
+/**
+ * @brief Factory for a kernel with scaled euclidean distance
+ * 
+ * @details Each statistic is divided by its scale before computing the
+ * distance. The kernel is uniform (as `kernel_fun_uniform`) or, if
+ * `gaussian = true`, gaussian (as `kernel_fun_gaussian`).
+ * 
+ * @tparam TData 
+ * @param scale Positive scale of each statistic (e.g., its MAD.)
+ * @param gaussian Whether to use the gaussian kernel.
+ * @return LFMCMCKernelFun<TData> 
+ */
+template<typename TData>
+inline LFMCMCKernelFun<TData> make_kernel_fun_scaled(
+    std::vector< epiworld_double > scale,
+    bool gaussian = false
+);
+
+/**
+ * @brief Factory for a kernel with Mahalanobis distance
+ * 
+ * @details Same as `make_kernel_fun_scaled()`, but the distance accounts for
+ * the correlation between statistics.
+ * 
+ * @tparam TData 
+ * @param covariance Positive definite covariance matrix of the statistics
+ * (row-major.)
+ * @param gaussian Whether to use the gaussian kernel.
+ * @return LFMCMCKernelFun<TData> 
+ */
+template<typename TData>
+inline LFMCMCKernelFun<TData> make_kernel_fun_mahalanobis(
+    const std::vector< epiworld_double > & covariance,
+    bool gaussian = false
+);
+
 /**
  * @brief Likelihood-Free Markov Chain Monte Carlo
  * 
@@ -116,6 +186,7 @@ inline epiworld_double kernel_fun_gaussian(
  */
 template<typename TData>
 class LFMCMC {
+    friend class ABCSMC<TData>;
 private:
 
     // Random number sampling
@@ -190,6 +261,88 @@ private:
     // Progress
     bool verbose = true;
     Progress progress_bar;
+
+    // Multiple chains and batched proposals
+    size_t m_n_chains     = 1u;
+    size_t m_batch_size   = 1u;
+    int    m_batch_nthreads = 1;
+    std::vector< epiworld_double > m_rhat; ///< Split R-hat of each parameter
+    std::vector< epiworld_double > m_ess;  ///< Effective sample size of each parameter
+
+    LFMCMC<TData> make_worker(unsigned int seed) const;
+
+    void get_columns(
+        std::vector< epiworld_double > & res,
+        const std::vector< epiworld_double > & x,
+        size_t n_cols,
+        size_t burnin
+    ) const;
+
+    std::vector< epiworld_double > get_quantiles(
+        const std::vector< epiworld_double > & x,
+        size_t n_cols,
+        const std::vector< epiworld_double > & probs,
+        size_t burnin
+    ) const;
+
+    // Simulation cache (see simulation_cache_on())
+    typedef std::vector< long long > CacheKey;
+    typedef std::list< std::pair< CacheKey, std::vector< epiworld_double > > > CacheList;
+    size_t m_cache_max_size = 0u; ///< Zero if the cache is off.
+    epiworld_double m_cache_resolution = 0.0;
+
+    /**
+     * @brief Entries of the simulation cache
+     * 
+     * @details The index points into the list, so copies rebuild it
+     * (moving a list keeps its iterators valid.)
+     */
+    struct SimulationCache {
+
+        CacheList lru; ///< Most recently used first.
+        std::map< CacheKey, typename CacheList::iterator > index;
+
+        SimulationCache() {};
+        SimulationCache(const SimulationCache & other) : lru(other.lru) {
+            rebuild();
+        };
+        SimulationCache(SimulationCache && other) = default;
+        SimulationCache & operator=(const SimulationCache & other) {
+            if (this != &other)
+            {
+                lru = other.lru;
+                rebuild();
+            }
+            return *this;
+        };
+        SimulationCache & operator=(SimulationCache && other) = default;
+
+        void rebuild() {
+            index.clear();
+            for (auto it = lru.begin(); it != lru.end(); ++it)
+                index[it->first] = it;
+        };
+
+        void clear() {
+            lru.clear();
+            index.clear();
+        };
+
+    };
+
+    SimulationCache m_cache;
+    size_t m_cache_hits   = 0u;
+    size_t m_cache_misses = 0u;
+
+    CacheKey cache_key(const std::vector< epiworld_double > & params) const;
+    bool cache_lookup(
+        const std::vector< epiworld_double > & params,
+        std::vector< epiworld_double > & stats
+    );
+    void cache_store(
+        const std::vector< epiworld_double > & params,
+        const std::vector< epiworld_double > & stats
+    );
     
 public:
 
@@ -200,6 +353,84 @@ public:
         int seed = -1
         );
 
+    /**
+     * @brief Runs independent chains in parallel
+     * 
+     * @details Each chain runs `run()` on its own copy of the sampler (with
+     * its own engine seeded from this one,) so the simulation, summary,
+     * proposal, and kernel functions must not share state across calls.
+     * The results of the chains are stored one after the other in the
+     * `m_all_sample_*` and `m_all_accepted_*` arrays (so chain `c` starts
+     * at sample `c * get_n_samples()`.) At the end, the split R-hat and
+     * the effective sample size of each parameter are computed (see
+     * `compute_diagnostics()`.)
+     * 
+     * @param params_init_ Initial parameters (the same for all chains.)
+     * @param n_samples_ Number of samples per chain.
+     * @param epsilon_ Epsilon parameter of the kernel.
+     * @param n_chains Number of chains.
+     * @param seed Seed for the master engine.
+     * @param nthreads Number of threads.
+     */
+    void run_chains(
+        std::vector< epiworld_double > params_init_,
+        size_t n_samples_,
+        epiworld_double epsilon_,
+        size_t n_chains,
+        int seed = -1,
+        int nthreads = 1
+        );
+
+    /**
+     * @brief Simulates proposals in batches
+     * 
+     * @details With `batch_size > 1`, `run()` makes `batch_size` proposals
+     * from the current state and simulates them concurrently (each on its
+     * own copy of the sampler.) Proposals are then accepted or rejected in
+     * order; once one is accepted, the rest are discarded. The result is a
+     * Metropolis chain, although not the same draws as with `batch_size = 1`.
+     * 
+     * @param batch_size Number of proposals per batch.
+     * @param nthreads Number of threads used to simulate a batch.
+     */
+    LFMCMC<TData> & set_batch_size(size_t batch_size, int nthreads = 1);
+
+    /**
+     * @brief Computes the convergence diagnostics
+     * 
+     * @details Computes the split R-hat and the effective sample size (ESS)
+     * of each parameter from the accepted parameters of all chains,
+     * dropping the first `burnin` samples of each chain. The ESS uses
+     * Geyer's initial monotone sequence. Both are `NaN` if a parameter is
+     * constant across all samples.
+     */
+    void compute_diagnostics(size_t burnin = 0u);
+
+    /**
+     * @name Simulation cache
+     * 
+     * @details With `simulation_cache_on()`, the summary statistics of each
+     * simulation are stored, keyed by the proposed parameters rounded to
+     * multiples of `resolution`. Proposals that fall in a stored key reuse
+     * the statistics instead of calling the simulation function. Up to
+     * `max_size` entries are kept (the least recently used are dropped.)
+     * The cache is cleared at the start of each run, and it is bypassed
+     * when the simulated data is being stored. With `run_chains()`, each
+     * chain has its own cache, and the counters are added up.
+     */
+    ///@{
+    LFMCMC<TData> & simulation_cache_on(
+        size_t max_size,
+        epiworld_double resolution
+    );
+    LFMCMC<TData> & simulation_cache_off();
+    bool is_simulation_cache_on() const {return m_cache_max_size > 0u;};
+    size_t get_cache_hits() const {return m_cache_hits;};
+    size_t get_cache_misses() const {return m_cache_misses;};
+    size_t get_cache_size() const {return m_cache.lru.size();};
+    epiworld_double get_cache_hit_rate() const;
+    ///@}
+
     LFMCMC() {};
     LFMCMC(const TData & observed_data_) : m_observed_data(observed_data_) {};
     ~LFMCMC() {};
@@ -238,6 +469,11 @@ public:
     size_t get_n_stats() const {return m_n_stats;};
     size_t get_n_params() const {return m_n_params;};
     epiworld_double get_epsilon() const {return m_epsilon;};
+    size_t get_n_chains() const {return m_n_chains;};
+    size_t get_batch_size() const {return m_batch_size;};
+
+    const std::vector< epiworld_double > & get_rhat() const {return m_rhat;};
+    const std::vector< epiworld_double > & get_ess() const {return m_ess;};
 
     const std::vector< epiworld_double > & get_initial_params() const {return m_initial_params;};
     const std::vector< epiworld_double > & get_current_proposed_params() const {return m_current_proposed_params;};
@@ -262,6 +498,53 @@ public:
     std::vector< epiworld_double > get_mean_params();
     std::vector< epiworld_double > get_mean_stats();
 
+    /**
+     * @name Posterior summaries
+     * 
+     * @details The samples are stored by row (one sample after the other.)
+     * `get_posterior_params()` and `get_posterior_stats()` return the
+     * accepted samples of all chains by column (all the samples of the first
+     * parameter, then the second, etc.), dropping the first `burnin` samples
+     * of each chain. The quantiles are computed on these columns using
+     * partial sorting and returned as a matrix with one row per parameter
+     * (or statistic) and one column per probability. The `p` quantile is the
+     * `floor(p * n)`-th smallest sample.
+     */
+    ///@{
+    std::vector< epiworld_double > get_posterior_params(size_t burnin = 0u) const;
+    std::vector< epiworld_double > get_posterior_stats(size_t burnin = 0u) const;
+    std::vector< epiworld_double > get_quantiles_params(
+        const std::vector< epiworld_double > & probs,
+        size_t burnin = 0u
+    ) const;
+    std::vector< epiworld_double > get_quantiles_stats(
+        const std::vector< epiworld_double > & probs,
+        size_t burnin = 0u
+    ) const;
+    ///@}
+
+    /**
+     * @brief Median absolute deviation of each statistic
+     * 
+     * @details Computed over all the sampled (proposed) statistics, so a
+     * pilot run can be used to scale the statistics in
+     * `make_kernel_fun_scaled()`.
+     */
+    std::vector< epiworld_double > get_stats_mad() const;
+
+    /**
+     * @brief Distances to the observed statistics
+     * 
+     * @param stats Matrix of statistics (one row per sample, e.g.,
+     * `get_all_sample_stats()`.)
+     * @param scale Optional scale of each statistic.
+     * @return The euclidean (or scaled) distance of each row.
+     */
+    std::vector< epiworld_double > get_distances(
+        const std::vector< epiworld_double > & stats,
+        const std::vector< epiworld_double > & scale = {}
+    ) const;
+
     // Printing
     LFMCMC<TData> & verbose_off();
     LFMCMC<TData> & verbose_on();
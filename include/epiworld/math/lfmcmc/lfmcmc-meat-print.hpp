@@ -23,58 +23,56 @@ inline void LFMCMC<TData>::print(size_t burnin) const
 
     }
 
+    // Samples are taken from all chains
+    n_samples_print *= m_n_chains;
     epiworld_double n_samples_dbl = static_cast< epiworld_double >(
         n_samples_print
         );
 
-    // Compute parameter summary values
+    // Means and the 95% Credible intervals (by column)
+    std::vector< epiworld_double > probs = {.025, .975};
+    std::vector< epiworld_double > cols;
+
+    get_columns(cols, m_all_accepted_params, m_n_params, burnin);
+    auto q_params = get_quantiles(m_all_accepted_params, m_n_params, probs, burnin);
     for (size_t k = 0u; k < m_n_params; ++k)
     {
 
-        // Retrieving the relevant parameter
-        std::vector< epiworld_double > par_i(n_samples_print);
-        for (size_t i = burnin; i < m_n_samples; ++i)
-        {
-            par_i[i-burnin] = m_all_accepted_params[i * m_n_params + k];
-            summ_params[k * 3] += par_i[i-burnin]/n_samples_dbl;
-        }
+        const epiworld_double * par_k = cols.data() + k * n_samples_print;
+        for (size_t j = 0u; j < n_samples_print; ++j)
+            summ_params[k * 3] += par_k[j];
 
-        // Computing the 95% Credible interval
-        std::sort(par_i.begin(), par_i.end());
-
-        summ_params[k * 3 + 1u] = 
-            par_i[std::floor(.025 * n_samples_dbl)];
-        summ_params[k * 3 + 2u] = 
-            par_i[std::floor(.975 * n_samples_dbl)];
+        summ_params[k * 3] /= n_samples_dbl;
+        summ_params[k * 3 + 1u] = q_params[k * 2u];
+        summ_params[k * 3 + 2u] = q_params[k * 2u + 1u];
 
     }
 
-    // Compute statistics summary values
+    get_columns(cols, m_all_accepted_stats, m_n_stats, burnin);
+    auto q_stats = get_quantiles(m_all_accepted_stats, m_n_stats, probs, burnin);
     for (size_t k = 0u; k < m_n_stats; ++k)
     {
 
-        // Retrieving the relevant parameter
-        std::vector< epiworld_double > stat_k(n_samples_print);
-        for (size_t i = burnin; i < m_n_samples; ++i)
-        {
-            stat_k[i-burnin] = m_all_accepted_stats[i * m_n_stats + k];
-            summ_stats[k * 3] += stat_k[i-burnin]/n_samples_dbl;
-        }
+        const epiworld_double * stat_k = cols.data() + k * n_samples_print;
+        for (size_t j = 0u; j < n_samples_print; ++j)
+            summ_stats[k * 3] += stat_k[j];
 
-        // Computing the 95% Credible interval
-        std::sort(stat_k.begin(), stat_k.end());
-        summ_stats[k * 3 + 1u] = 
-            stat_k[std::floor(.025 * n_samples_dbl)];
-        summ_stats[k * 3 + 2u] = 
-            stat_k[std::floor(.975 * n_samples_dbl)];
+        summ_stats[k * 3] /= n_samples_dbl;
+        summ_stats[k * 3 + 1u] = q_stats[k * 2u];
+        summ_stats[k * 3 + 2u] = q_stats[k * 2u + 1u];
 
     }
 
     printf_epiworld("___________________________________________\n\n");
     printf_epiworld("LIKELIHOOD-FREE MARKOV CHAIN MONTE CARLO\n\n");
 
-    printf_epiworld("N Samples (total) : %zu\n", m_n_samples);
-    printf_epiworld("N Samples (after burn-in period) : %zu\n", m_n_samples - burnin);
+    if (m_n_chains > 1u)
+    {
+        printf_epiworld("N Chains : %zu\n", m_n_chains);
+    }
+
+    printf_epiworld("N Samples (total) : %zu\n", m_n_samples * m_n_chains);
+    printf_epiworld("N Samples (after burn-in period) : %zu\n", n_samples_print);
 
     std::string abbr;
     epiworld_double elapsed;
@@ -243,6 +241,25 @@ inline void LFMCMC<TData>::print(size_t burnin) const
 
     }
 
+    if ((m_n_chains > 1u) && (m_rhat.size() == m_n_params))
+    {
+
+        printf_epiworld("\nConvergence (R-hat, ESS):\n");
+        for (size_t k = 0u; k < m_n_params; ++k)
+        {
+            if (m_param_names.size() != 0u)
+            {
+                printf_epiworld(
+                    "  -%s : %.3f, %.0f\n", m_param_names[k].c_str(),
+                    m_rhat[k], m_ess[k]
+                    );
+            } else {
+                printf_epiworld("  [%-2ld]: %.3f, %.0f\n", k, m_rhat[k], m_ess[k]);
+            }
+        }
+
+    }
+
     printf_epiworld("___________________________________________\n\n");
 }
 
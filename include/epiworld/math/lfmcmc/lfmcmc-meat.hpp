@@ -121,6 +121,75 @@ inline void proposal_fun_unif(
     return;
 }
 
+inline epiworld_double sq_dist_euclidean(
+    const epiworld_double * x,
+    const epiworld_double * y,
+    size_t n
+) {
+
+    epiworld_double ans = 0.0;
+
+    #if defined(__OPENMP) || defined(_OPENMP)
+    #pragma omp simd reduction(+:ans)
+    #endif
+    for (size_t k = 0u; k < n; ++k)
+        ans += (x[k] - y[k]) * (x[k] - y[k]);
+
+    return ans;
+
+}
+
+inline epiworld_double sq_dist_scaled(
+    const epiworld_double * x,
+    const epiworld_double * y,
+    const epiworld_double * inv_scale,
+    size_t n
+) {
+
+    epiworld_double ans = 0.0;
+
+    #if defined(__OPENMP) || defined(_OPENMP)
+    #pragma omp simd reduction(+:ans)
+    #endif
+    for (size_t k = 0u; k < n; ++k)
+    {
+        epiworld_double d = (x[k] - y[k]) * inv_scale[k];
+        ans += d * d;
+    }
+
+    return ans;
+
+}
+
+inline epiworld_double sq_dist_mahalanobis(
+    const epiworld_double * x,
+    const epiworld_double * y,
+    const epiworld_double * inv_chol,
+    size_t n
+) {
+
+    // Squared norm of inv_chol * (x - y), where inv_chol is lower triangular
+    epiworld_double ans = 0.0;
+    for (size_t i = 0u; i < n; ++i)
+    {
+
+        const epiworld_double * row = inv_chol + i * n;
+        epiworld_double z = 0.0;
+
+        #if defined(__OPENMP) || defined(_OPENMP)
+        #pragma omp simd reduction(+:z)
+        #endif
+        for (size_t j = 0u; j <= i; ++j)
+            z += row[j] * (x[j] - y[j]);
+
+        ans += z * z;
+
+    }
+
+    return ans;
+
+}
+
 /**
  * @brief Uses the uniform kernel with euclidean distance
  * 
@@ -136,12 +205,12 @@ inline epiworld_double kernel_fun_uniform(
     const std::vector< epiworld_double >& simulated_stats,
     const std::vector< epiworld_double >& observed_stats,
     epiworld_double epsilon,
-    LFMCMC<TData>* m
+    LFMCMC<TData>*
 ) {
 
-    epiworld_double ans = 0.0;
-    for (size_t p = 0u; p < m->get_n_params(); ++p)
-        ans += std::pow(observed_stats[p] - simulated_stats[p], 2.0);
+    epiworld_double ans = sq_dist_euclidean(
+        observed_stats.data(), simulated_stats.data(), observed_stats.size()
+        );
 
     return std::sqrt(ans) < epsilon ? 1.0 : 0.0;
 
@@ -165,16 +234,158 @@ inline epiworld_double kernel_fun_gaussian(
     const std::vector< epiworld_double >& simulated_stats,
     const std::vector< epiworld_double >& observed_stats,
     epiworld_double epsilon,
-    LFMCMC<TData>* m
+    LFMCMC<TData>*
 ) {
 
-    epiworld_double ans = 0.0;
-    for (size_t p = 0u; p < m->get_n_params(); ++p)
-        ans += std::pow(observed_stats[p] - simulated_stats[p], 2.0);
+    epiworld_double ans = sq_dist_euclidean(
+        observed_stats.data(), simulated_stats.data(), observed_stats.size()
+        );
 
-    return std::exp(
-        -.5 * (ans/std::pow(1 + std::pow(epsilon, 2.0)/3.0, 2.0))
-        ) / sqrt2pi() ;
+    epiworld_double s = 1.0 + epsilon * epsilon / 3.0;
+
+    return std::exp(-.5 * (ans / (s * s))) / sqrt2pi();
+
+}
+
+template<typename TData>
+inline LFMCMCKernelFun<TData> make_kernel_fun_scaled(
+    std::vector< epiworld_double > scale,
+    bool gaussian
+) {
+
+    std::vector< epiworld_double > inv_scale(scale.size());
+    for (size_t k = 0u; k < scale.size(); ++k)
+    {
+
+        if (!(scale[k] > 0.0))
+            throw std::invalid_argument(
+                "The scale of statistic " + std::to_string(k) +
+                " must be positive."
+                );
+
+        inv_scale[k] = 1.0 / scale[k];
+
+    }
+
+    LFMCMCKernelFun<TData> fun =
+        [inv_scale,gaussian](
+            const std::vector< epiworld_double >& simulated_stats,
+            const std::vector< epiworld_double >& observed_stats,
+            epiworld_double epsilon,
+            LFMCMC<TData>*
+        ) -> epiworld_double {
+
+        if (observed_stats.size() != inv_scale.size())
+            throw std::length_error(
+                "The number of scales does not match the number of statistics."
+                );
+
+        epiworld_double ans = sq_dist_scaled(
+            observed_stats.data(), simulated_stats.data(), inv_scale.data(),
+            inv_scale.size()
+            );
+
+        if (!gaussian)
+            return std::sqrt(ans) < epsilon ? 1.0 : 0.0;
+
+        epiworld_double s = 1.0 + epsilon * epsilon / 3.0;
+        return std::exp(-.5 * (ans / (s * s))) / sqrt2pi();
+
+    };
+
+    return fun;
+
+}
+
+template<typename TData>
+inline LFMCMCKernelFun<TData> make_kernel_fun_mahalanobis(
+    const std::vector< epiworld_double > & covariance,
+    bool gaussian
+) {
+
+    size_t n = static_cast< size_t >(
+        std::round(std::sqrt(static_cast< double >(covariance.size())))
+        );
+
+    if (n * n != covariance.size())
+        throw std::length_error("The covariance matrix must be square.");
+
+    // Cholesky factor (covariance = L * L')
+    std::vector< double > L(n * n, 0.0);
+    for (size_t i = 0u; i < n; ++i)
+    {
+        for (size_t j = 0u; j <= i; ++j)
+        {
+
+            double sum = static_cast< double >(covariance[i * n + j]);
+            for (size_t k = 0u; k < j; ++k)
+                sum -= L[i * n + k] * L[j * n + k];
+
+            if (i != j)
+            {
+                L[i * n + j] = sum / L[j * n + j];
+                continue;
+            }
+
+            if (!(sum > 0.0))
+                throw std::domain_error(
+                    "The covariance matrix is not positive definite."
+                    );
+
+            L[i * n + i] = std::sqrt(sum);
+
+        }
+    }
+
+    // Inverse of L (also lower triangular)
+    std::vector< epiworld_double > inv_chol(n * n, 0.0);
+    std::vector< double > col(n);
+    for (size_t j = 0u; j < n; ++j)
+    {
+
+        col[j] = 1.0 / L[j * n + j];
+        for (size_t i = j + 1u; i < n; ++i)
+        {
+
+            double sum = 0.0;
+            for (size_t k = j; k < i; ++k)
+                sum += L[i * n + k] * col[k];
+
+            col[i] = -sum / L[i * n + i];
+
+        }
+
+        for (size_t i = j; i < n; ++i)
+            inv_chol[i * n + j] = static_cast< epiworld_double >(col[i]);
+
+    }
+
+    LFMCMCKernelFun<TData> fun =
+        [inv_chol,n,gaussian](
+            const std::vector< epiworld_double >& simulated_stats,
+            const std::vector< epiworld_double >& observed_stats,
+            epiworld_double epsilon,
+            LFMCMC<TData>*
+        ) -> epiworld_double {
+
+        if (observed_stats.size() != n)
+            throw std::length_error(
+                "The size of the covariance matrix does not match the number of statistics."
+                );
+
+        epiworld_double ans = sq_dist_mahalanobis(
+            observed_stats.data(), simulated_stats.data(), inv_chol.data(), n
+            );
+
+        if (!gaussian)
+            return std::sqrt(ans) < epsilon ? 1.0 : 0.0;
+
+        epiworld_double s = 1.0 + epsilon * epsilon / 3.0;
+        return std::exp(-.5 * (ans / (s * s))) / sqrt2pi();
+
+    };
+
+    return fun;
 
 }
 
@@ -238,11 +449,16 @@ inline void LFMCMC<TData>::run(
     m_summary_fun(m_observed_stats, m_observed_data, this);
     m_n_stats = m_observed_stats.size();
 
+    // The cache is only valid within a run
+    m_cache.clear();
+    m_cache_hits   = 0u;
+    m_cache_misses = 0u;
+
     // Reserving size
     m_current_proposed_stats.resize(m_n_stats);
     m_current_accepted_stats.resize(m_n_stats);
     m_all_sample_drawn_prob.resize(m_n_samples);
-    m_all_sample_acceptance.resize(m_n_samples, false);
+    m_all_sample_acceptance.assign(m_n_samples, false);
     m_all_sample_params.resize(m_n_samples * m_n_params);
     m_all_sample_stats.resize(m_n_samples * m_n_stats);
     m_all_sample_kernel_scores.resize(m_n_samples);
@@ -254,13 +470,17 @@ inline void LFMCMC<TData>::run(
     TData data_i = m_simulation_fun(m_initial_params, this);
 
     m_summary_fun(m_current_proposed_stats, data_i, this);
+    cache_store(m_initial_params, m_current_proposed_stats);
     m_all_accepted_kernel_scores[0u] = m_kernel_fun(
         m_current_proposed_stats, m_observed_stats, m_epsilon, this
         );
 
     // Recording statistics
     for (size_t i = 0u; i < m_n_stats; ++i)
-        m_all_sample_stats[i] = m_current_proposed_stats[i];
+    {
+        m_all_sample_stats[i]   = m_current_proposed_stats[i];
+        m_all_accepted_stats[i] = m_current_proposed_stats[i];
+    }
     
     m_current_accepted_stats = m_current_proposed_stats;
 
@@ -276,76 +496,639 @@ inline void LFMCMC<TData>::run(
         progress_bar.next(); 
     }
 
+    // Workers simulating batched proposals (see set_batch_size())
+    std::vector< LFMCMC<TData> > workers;
+    std::vector< std::vector< epiworld_double > > batch_params;
+    std::vector< std::vector< epiworld_double > > batch_stats;
+    std::vector< std::shared_ptr< TData > > batch_data;
+    if (m_batch_size > 1u)
+    {
+
+        for (size_t b = 0u; b < m_batch_size; ++b)
+            workers.push_back(make_worker(
+                static_cast< unsigned int >((*m_engine)())
+            ));
+
+        batch_params.resize(m_batch_size, m_current_proposed_params);
+        batch_stats.resize(m_batch_size, m_current_proposed_stats);
+        batch_data.resize(m_batch_size);
+
+    }
+
     // Run LFMCMC
-    for (size_t i = 1u; i < m_n_samples; ++i)
+    size_t i = 1u;
+    while (i < m_n_samples)
     {
-        // Step 1: Generate a proposal and store it in m_current_proposed_params
-        m_proposal_fun(m_current_proposed_params, m_current_accepted_params, this);
 
-        // Step 2: Using m_current_proposed_params, simulate data
-        TData data_i = m_simulation_fun(m_current_proposed_params, this);
+        size_t n_batch = 1u;
+        if (m_batch_size > 1u)
+        {
 
-        // Are we storing the data?
-        if (m_simulated_data != nullptr)
-            m_simulated_data->operator[](i) = data_i;
+            // Step 1 and 2 (batched): All proposals are made from the
+            // current state and simulated concurrently by the workers. These
+            // are then processed in order until one is accepted (the rest
+            // are discarded), so the chain is the same Metropolis chain.
+            n_batch = std::min(m_batch_size, m_n_samples - i);
+            for (size_t b = 0u; b < n_batch; ++b)
+                m_proposal_fun(batch_params[b], m_current_accepted_params, this);
+
+            // Only proposals missing from the cache are simulated
+            std::vector< char > cached(n_batch, 0);
+            for (size_t b = 0u; b < n_batch; ++b)
+                cached[b] = cache_lookup(batch_params[b], batch_stats[b]);
+
+            std::vector< std::exception_ptr > errors(n_batch, nullptr);
+
+            #if defined(_OPENMP) || defined(__OPENMP)
+            #pragma omp parallel for num_threads(m_batch_nthreads) schedule(dynamic)
+            #endif
+            for (int b = 0; b < static_cast< int >(n_batch); ++b)
+            {
 
-        // Step 3: Generate the summary statistics of the data
-        m_summary_fun(m_current_proposed_stats, data_i, this);
+                if (cached[b])
+                    continue;
 
-        // Step 4: Compute the hastings ratio using the kernel function
-        epiworld_double hr = m_kernel_fun(
-            m_current_proposed_stats, m_observed_stats, m_epsilon, this
-            );
+                auto & worker = workers[b];
 
-        m_all_sample_kernel_scores[i] = hr;
+                try
+                {
+                    worker.m_current_proposed_params = batch_params[b];
+                    batch_data[b] = std::make_shared< TData >(
+                        m_simulation_fun(batch_params[b], &worker)
+                    );
+                    m_summary_fun(batch_stats[b], *batch_data[b], &worker);
+                }
+                catch (...)
+                {
+                    errors[b] = std::current_exception();
+                }
 
-        // Storing data
-        for (size_t k = 0u; k < m_n_params; ++k)
-            m_all_sample_params[i * m_n_params + k] = m_current_proposed_params[k];
+            }
 
-        for (size_t k = 0u; k < m_n_stats; ++k)
-            m_all_sample_stats[i * m_n_stats + k] = m_current_proposed_stats[k];
-        
-        // Running Hastings ratio
-        epiworld_double r = runif();
-        m_all_sample_drawn_prob[i] = r;
+            for (auto & e : errors)
+                if (e)
+                    std::rethrow_exception(e);
 
-        // Step 5: Update if likely
-        if (r < std::min(static_cast<epiworld_double>(1.0), hr / m_all_accepted_kernel_scores[i - 1u]))
-        {
-            m_all_accepted_kernel_scores[i] = hr;
-            m_all_sample_acceptance[i]     = true;
-            
-            for (size_t k = 0u; k < m_n_stats; ++k)
-                m_all_accepted_stats[i * m_n_stats + k] =
-                    m_current_proposed_stats[k];
+            for (size_t b = 0u; b < n_batch; ++b)
+                if (!cached[b])
+                    cache_store(batch_params[b], batch_stats[b]);
 
-            m_current_accepted_params = m_current_proposed_params;
-            m_current_accepted_stats = m_current_proposed_stats;
-        } else
+        }
+
+        for (size_t b = 0u; b < n_batch; ++b, ++i)
         {
 
+            if (m_batch_size > 1u)
+            {
+
+                m_current_proposed_params = batch_params[b];
+                m_current_proposed_stats  = batch_stats[b];
+
+                if (m_simulated_data != nullptr)
+                    m_simulated_data->operator[](i) = *batch_data[b];
+
+            } else {
+
+                // Step 1: Generate a proposal and store it in m_current_proposed_params
+                m_proposal_fun(m_current_proposed_params, m_current_accepted_params, this);
+
+                // Step 2 and 3: Using m_current_proposed_params, simulate
+                // data and generate the summary statistics (unless cached)
+                if (!cache_lookup(m_current_proposed_params, m_current_proposed_stats))
+                {
+
+                    TData data_i = m_simulation_fun(m_current_proposed_params, this);
+
+                    // Are we storing the data?
+                    if (m_simulated_data != nullptr)
+                        m_simulated_data->operator[](i) = data_i;
+
+                    m_summary_fun(m_current_proposed_stats, data_i, this);
+                    cache_store(m_current_proposed_params, m_current_proposed_stats);
+
+                }
+
+            }
+
+            // Step 4: Compute the hastings ratio using the kernel function
+            epiworld_double hr = m_kernel_fun(
+                m_current_proposed_stats, m_observed_stats, m_epsilon, this
+                );
+
+            m_all_sample_kernel_scores[i] = hr;
+
+            // Storing data
+            for (size_t k = 0u; k < m_n_params; ++k)
+                m_all_sample_params[i * m_n_params + k] = m_current_proposed_params[k];
+
             for (size_t k = 0u; k < m_n_stats; ++k)
-                m_all_accepted_stats[i * m_n_stats + k] =
-                    m_all_accepted_stats[(i - 1) * m_n_stats + k];
+                m_all_sample_stats[i * m_n_stats + k] = m_current_proposed_stats[k];
+            
+            // Running Hastings ratio
+            epiworld_double r = runif();
+            m_all_sample_drawn_prob[i] = r;
+
+            // Step 5: Update if likely
+            bool accepted = false;
+            if (r < std::min(static_cast<epiworld_double>(1.0), hr / m_all_accepted_kernel_scores[i - 1u]))
+            {
+                m_all_accepted_kernel_scores[i] = hr;
+                m_all_sample_acceptance[i]     = true;
+                
+                for (size_t k = 0u; k < m_n_stats; ++k)
+                    m_all_accepted_stats[i * m_n_stats + k] =
+                        m_current_proposed_stats[k];
+
+                m_current_accepted_params = m_current_proposed_params;
+                m_current_accepted_stats = m_current_proposed_stats;
+
+                accepted = true;
+            } else
+            {
+
+                for (size_t k = 0u; k < m_n_stats; ++k)
+                    m_all_accepted_stats[i * m_n_stats + k] =
+                        m_all_accepted_stats[(i - 1) * m_n_stats + k];
+
+                m_all_accepted_kernel_scores[i] = m_all_accepted_kernel_scores[i - 1u];
+            }
+                
+
+            for (size_t k = 0u; k < m_n_params; ++k)
+                m_all_accepted_params[i * m_n_params + k] = m_current_accepted_params[k];
+
+            if (verbose) { 
+                progress_bar.next(); 
+            }
+
+            // The remaining proposals were made from the previous state
+            if (accepted)
+            {
+                ++i;
+                break;
+            }
 
-            m_all_accepted_kernel_scores[i] = m_all_accepted_kernel_scores[i - 1u];
         }
-            
 
-        for (size_t k = 0u; k < m_n_params; ++k)
-            m_all_accepted_params[i * m_n_params + k] = m_current_accepted_params[k];
+    }
+
+    // Single chain
+    m_n_chains = 1u;
+    compute_diagnostics();
+
+    // End timing
+    chrono_end();
+
+}
+
+
+template<typename TData>
+inline LFMCMC<TData> LFMCMC<TData>::make_worker(unsigned int seed) const
+{
+
+    LFMCMC<TData> worker;
+
+    // Own engine and distributions (these hold state)
+    worker.m_engine = std::make_shared< std::mt19937 >(seed);
+    worker.runifd   = std::make_shared< std::uniform_real_distribution<> >(
+        runifd->param()
+    );
+    worker.rnormd   = std::make_shared< std::normal_distribution<> >(
+        rnormd->param()
+    );
+    worker.rgammad  = std::make_shared< std::gamma_distribution<> >(
+        rgammad->param()
+    );
+
+    worker.m_observed_data   = m_observed_data;
+    worker.m_n_samples       = m_n_samples;
+    worker.m_n_stats         = m_n_stats;
+    worker.m_n_params        = m_n_params;
+    worker.m_epsilon         = m_epsilon;
+    worker.m_initial_params  = m_initial_params;
+    worker.m_observed_stats  = m_observed_stats;
+    worker.m_current_proposed_params = m_current_proposed_params;
+    worker.m_current_accepted_params = m_current_accepted_params;
+
+    worker.m_simulation_fun = m_simulation_fun;
+    worker.m_summary_fun    = m_summary_fun;
+    worker.m_proposal_fun   = m_proposal_fun;
+    worker.m_kernel_fun     = m_kernel_fun;
+
+    worker.m_param_names = m_param_names;
+    worker.m_stat_names  = m_stat_names;
+
+    worker.m_batch_size     = m_batch_size;
+    worker.m_batch_nthreads = m_batch_nthreads;
+
+    worker.m_cache_max_size   = m_cache_max_size;
+    worker.m_cache_resolution = m_cache_resolution;
+    worker.verbose = false;
+
+    return worker;
+
+}
 
-        if (verbose) { 
-            progress_bar.next(); 
+template<typename TData>
+inline void LFMCMC<TData>::run_chains(
+    std::vector< epiworld_double > params_init_,
+    size_t n_samples_,
+    epiworld_double epsilon_,
+    size_t n_chains,
+    int seed,
+    int nthreads
+    )
+{
+
+    if (n_chains == 0u)
+        throw std::invalid_argument("The number of chains must be at least 1.");
+
+    if (n_samples_ < 2u)
+        throw std::invalid_argument(
+            "Each chain must have at least 2 samples."
+        );
+
+    // Starting timing
+    chrono_start();
+
+    if (m_engine == nullptr)
+        m_engine = std::make_shared< std::mt19937 >();
+
+    if (seed >= 0)
+        this->seed(seed);
+
+    m_n_samples      = n_samples_;
+    m_epsilon        = epsilon_;
+    m_initial_params = params_init_;
+    m_n_params       = params_init_.size();
+
+    // Computing the baseline sufficient statistics
+    m_summary_fun(m_observed_stats, m_observed_data, this);
+    m_n_stats = m_observed_stats.size();
+
+    // Each chain gets its own engine, seeded from the master
+    std::vector< LFMCMC<TData> > chains;
+    std::vector< unsigned int > seeds(n_chains);
+    for (auto & s : seeds)
+        s = static_cast< unsigned int >((*m_engine)());
+
+    for (size_t c = 0u; c < n_chains; ++c)
+        chains.push_back(make_worker(seeds[c]));
+
+    std::vector< std::vector< TData > > chains_data(
+        m_simulated_data != nullptr ? n_chains : 0u
+    );
+    for (size_t c = 0u; c < chains_data.size(); ++c)
+        chains[c].m_simulated_data = &chains_data[c];
+
+    std::vector< std::exception_ptr > errors(n_chains, nullptr);
+
+    #if defined(_OPENMP) || defined(__OPENMP)
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+    #else
+    (void) nthreads;
+    #endif
+    for (int c = 0; c < static_cast< int >(n_chains); ++c)
+    {
+
+        try
+        {
+            chains[c].run(params_init_, n_samples_, epsilon_);
         }
+        catch (...)
+        {
+            errors[c] = std::current_exception();
+        }
+
+    }
+
+    for (auto & e : errors)
+        if (e)
+            std::rethrow_exception(e);
+
+    // Collecting the chains (one after the other)
+    m_n_chains = n_chains;
+    size_t n = n_samples_ * n_chains;
+
+    m_all_sample_params.clear();
+    m_all_sample_stats.clear();
+    m_all_sample_acceptance.clear();
+    m_all_sample_drawn_prob.clear();
+    m_all_sample_kernel_scores.clear();
+    m_all_accepted_params.clear();
+    m_all_accepted_stats.clear();
+    m_all_accepted_kernel_scores.clear();
+
+    m_all_sample_params.reserve(n * m_n_params);
+    m_all_sample_stats.reserve(n * m_n_stats);
+    m_all_sample_acceptance.reserve(n);
+    m_all_sample_drawn_prob.reserve(n);
+    m_all_sample_kernel_scores.reserve(n);
+    m_all_accepted_params.reserve(n * m_n_params);
+    m_all_accepted_stats.reserve(n * m_n_stats);
+    m_all_accepted_kernel_scores.reserve(n);
+
+    #define EPI_APPEND_(a) a.insert(a.end(), chain.a.begin(), chain.a.end());
+    for (auto & chain : chains)
+    {
+        EPI_APPEND_(m_all_sample_params)
+        EPI_APPEND_(m_all_sample_stats)
+        EPI_APPEND_(m_all_sample_acceptance)
+        EPI_APPEND_(m_all_sample_drawn_prob)
+        EPI_APPEND_(m_all_sample_kernel_scores)
+        EPI_APPEND_(m_all_accepted_params)
+        EPI_APPEND_(m_all_accepted_stats)
+        EPI_APPEND_(m_all_accepted_kernel_scores)
+    }
+    #undef EPI_APPEND_
+
+    if (m_simulated_data != nullptr)
+    {
+        m_simulated_data->clear();
+        for (auto & d : chains_data)
+            m_simulated_data->insert(m_simulated_data->end(), d.begin(), d.end());
     }
 
+    m_cache_hits   = 0u;
+    m_cache_misses = 0u;
+    for (auto & chain : chains)
+    {
+        m_cache_hits   += chain.m_cache_hits;
+        m_cache_misses += chain.m_cache_misses;
+    }
+
+    // The current state is that of the last chain
+    m_current_proposed_params = chains.back().m_current_proposed_params;
+    m_current_accepted_params = chains.back().m_current_accepted_params;
+    m_current_proposed_stats  = chains.back().m_current_proposed_stats;
+    m_current_accepted_stats  = chains.back().m_current_accepted_stats;
+
+    compute_diagnostics();
+
     // End timing
     chrono_end();
 
 }
 
+template<typename TData>
+inline LFMCMC<TData> & LFMCMC<TData>::set_batch_size(
+    size_t batch_size,
+    int nthreads
+)
+{
+
+    if (batch_size == 0u)
+        throw std::invalid_argument("The batch size must be at least 1.");
+
+    m_batch_size     = batch_size;
+    m_batch_nthreads = nthreads;
+
+    return *this;
+
+}
+
+template<typename TData>
+inline LFMCMC<TData> & LFMCMC<TData>::simulation_cache_on(
+    size_t max_size,
+    epiworld_double resolution
+)
+{
+
+    if (max_size == 0u)
+        throw std::invalid_argument("The size of the cache must be at least 1.");
+
+    if (!(resolution > 0.0))
+        throw std::invalid_argument("The resolution of the cache must be positive.");
+
+    m_cache_max_size   = max_size;
+    m_cache_resolution = resolution;
+
+    return *this;
+
+}
+
+template<typename TData>
+inline LFMCMC<TData> & LFMCMC<TData>::simulation_cache_off()
+{
+
+    m_cache_max_size = 0u;
+    m_cache.clear();
+
+    return *this;
+
+}
+
+template<typename TData>
+inline epiworld_double LFMCMC<TData>::get_cache_hit_rate() const
+{
+
+    size_t n = m_cache_hits + m_cache_misses;
+    if (n == 0u)
+        return 0.0;
+
+    return static_cast< epiworld_double >(m_cache_hits) /
+        static_cast< epiworld_double >(n);
+
+}
+
+template<typename TData>
+inline typename LFMCMC<TData>::CacheKey LFMCMC<TData>::cache_key(
+    const std::vector< epiworld_double > & params
+) const
+{
+
+    CacheKey key(params.size());
+    for (size_t k = 0u; k < params.size(); ++k)
+        key[k] = std::llround(params[k] / m_cache_resolution);
+
+    return key;
+
+}
+
+template<typename TData>
+inline bool LFMCMC<TData>::cache_lookup(
+    const std::vector< epiworld_double > & params,
+    std::vector< epiworld_double > & stats
+)
+{
+
+    if ((m_cache_max_size == 0u) || (m_simulated_data != nullptr))
+        return false;
+
+    auto it = m_cache.index.find(cache_key(params));
+    if (it == m_cache.index.end())
+    {
+        ++m_cache_misses;
+        return false;
+    }
+
+    // Moving the entry to the front
+    m_cache.lru.splice(m_cache.lru.begin(), m_cache.lru, it->second);
+    stats = it->second->second;
+    ++m_cache_hits;
+
+    return true;
+
+}
+
+template<typename TData>
+inline void LFMCMC<TData>::cache_store(
+    const std::vector< epiworld_double > & params,
+    const std::vector< epiworld_double > & stats
+)
+{
+
+    if ((m_cache_max_size == 0u) || (m_simulated_data != nullptr))
+        return;
+
+    CacheKey key = cache_key(params);
+    if (m_cache.index.find(key) != m_cache.index.end())
+        return;
+
+    // Dropping the least recently used entry
+    if (m_cache.lru.size() >= m_cache_max_size)
+    {
+        m_cache.index.erase(m_cache.lru.back().first);
+        m_cache.lru.pop_back();
+    }
+
+    m_cache.lru.emplace_front(key, stats);
+    m_cache.index[std::move(key)] = m_cache.lru.begin();
+
+}
+
+template<typename TData>
+inline void LFMCMC<TData>::compute_diagnostics(size_t burnin)
+{
+
+    if (burnin >= m_n_samples)
+        throw std::length_error(
+            "The burnin is greater than or equal to the number of samples."
+            );
+
+    // Each chain is split in two halves (split R-hat)
+    size_t n_half = (m_n_samples - burnin) / 2u;
+    size_t n_seq  = m_n_chains * 2u;
+
+    m_rhat.assign(m_n_params, std::numeric_limits< epiworld_double >::quiet_NaN());
+    m_ess.assign(m_n_params, std::numeric_limits< epiworld_double >::quiet_NaN());
+
+    if (n_half < 2u)
+        return;
+
+    std::vector< double > x(n_seq * n_half);
+    std::vector< double > means(n_seq);
+    std::vector< double > vars(n_seq);
+    for (size_t k = 0u; k < m_n_params; ++k)
+    {
+
+        // Collecting the sequences (contiguous)
+        for (size_t c = 0u; c < m_n_chains; ++c)
+        {
+
+            const epiworld_double * chain = m_all_accepted_params.data() +
+                (c * m_n_samples + burnin) * m_n_params + k;
+
+            // The second half starts after the last sample of the first
+            // one (an odd sample is dropped)
+            size_t n_kept = m_n_samples - burnin;
+            for (size_t h = 0u; h < 2u; ++h)
+            {
+                double * seq = x.data() + (c * 2u + h) * n_half;
+                size_t start = h * (n_kept - n_half);
+                for (size_t i = 0u; i < n_half; ++i)
+                    seq[i] = static_cast< double >(chain[(start + i) * m_n_params]);
+            }
+
+        }
+
+        double W = 0.0, mean_all = 0.0;
+        for (size_t s = 0u; s < n_seq; ++s)
+        {
+
+            const double * seq = x.data() + s * n_half;
+            double m = 0.0;
+            for (size_t i = 0u; i < n_half; ++i)
+                m += seq[i];
+
+            m /= static_cast< double >(n_half);
+
+            double v = 0.0;
+            for (size_t i = 0u; i < n_half; ++i)
+                v += (seq[i] - m) * (seq[i] - m);
+
+            means[s] = m;
+            vars[s]  = v / static_cast< double >(n_half - 1u);
+            W        += vars[s] / static_cast< double >(n_seq);
+            mean_all += m / static_cast< double >(n_seq);
+
+        }
+
+        double B = 0.0;
+        for (size_t s = 0u; s < n_seq; ++s)
+            B += (means[s] - mean_all) * (means[s] - mean_all);
+
+        B *= static_cast< double >(n_half) / static_cast< double >(n_seq - 1u);
+
+        double nh = static_cast< double >(n_half);
+        double var_plus = (nh - 1.0) / nh * W + B / nh;
+
+        // Constant chains carry no information
+        if (W <= 0.0)
+            continue;
+
+        m_rhat[k] = static_cast< epiworld_double >(std::sqrt(var_plus / W));
+
+        // Effective sample size, using Geyer's initial positive sequence
+        // on the autocorrelations combined across sequences
+        auto rho = [&](size_t t) -> double {
+
+            double acov = 0.0;
+            for (size_t s = 0u; s < n_seq; ++s)
+            {
+                const double * seq = x.data() + s * n_half;
+                double m = means[s];
+                double a = 0.0;
+                for (size_t i = 0u; i + t < n_half; ++i)
+                    a += (seq[i] - m) * (seq[i + t] - m);
+
+                acov += a / nh;
+            }
+
+            acov /= static_cast< double >(n_seq);
+
+            return 1.0 - (W - acov) / var_plus;
+
+        };
+
+        double tau = 0.0;
+        double pair_prev = std::numeric_limits< double >::max();
+        for (size_t t = 0u; (t + 1u) < n_half; t += 2u)
+        {
+
+            double pair = (t == 0u ? 1.0 : rho(t)) + rho(t + 1u);
+
+            if (pair <= 0.0)
+                break;
+
+            // Monotone sequence
+            pair      = std::min(pair, pair_prev);
+            pair_prev = pair;
+            tau      += pair;
+
+        }
+
+        tau = 2.0 * tau - 1.0;
+
+        m_ess[k] = static_cast< epiworld_double >(
+            static_cast< double >(n_seq) * nh / std::max(tau, 1.0 / std::log10(
+                static_cast< double >(n_seq) * nh
+            ))
+        );
+
+    }
+
+}
 
 template<typename TData>
 inline epiworld_double LFMCMC<TData>::runif()
@@ -536,13 +1319,16 @@ template<typename TData>
 inline std::vector< epiworld_double > LFMCMC<TData>::get_mean_params()
 {
     std::vector< epiworld_double > res(this->m_n_params, 0.0);
-    
-    for (size_t k = 0u; k < m_n_params; ++k)
-    {
-        for (size_t i = 0u; i < m_n_samples; ++i)
-            res[k] += (this->m_all_accepted_params[k + m_n_params * i])/
-                static_cast< epiworld_double >(m_n_samples);
-    }
+    size_t n = m_n_samples * m_n_chains;
+
+    // Row by row (contiguous)
+    const epiworld_double * x = m_all_accepted_params.data();
+    for (size_t i = 0u; i < n; ++i, x += m_n_params)
+        for (size_t k = 0u; k < m_n_params; ++k)
+            res[k] += x[k];
+
+    for (auto & r : res)
+        r /= static_cast< epiworld_double >(n);
 
     return res;
 
@@ -552,18 +1338,216 @@ template<typename TData>
 inline std::vector< epiworld_double > LFMCMC<TData>::get_mean_stats()
 {
     std::vector< epiworld_double > res(this->m_n_stats, 0.0);
-    
+    size_t n = m_n_samples * m_n_chains;
+
+    const epiworld_double * x = m_all_accepted_stats.data();
+    for (size_t i = 0u; i < n; ++i, x += m_n_stats)
+        for (size_t k = 0u; k < m_n_stats; ++k)
+            res[k] += x[k];
+
+    for (auto & r : res)
+        r /= static_cast< epiworld_double >(n);
+
+    return res;
+
+}
+
+template<typename TData>
+inline void LFMCMC<TData>::get_columns(
+    std::vector< epiworld_double > & res,
+    const std::vector< epiworld_double > & x,
+    size_t n_cols,
+    size_t burnin
+) const
+{
+
+    if (burnin >= m_n_samples)
+        throw std::length_error(
+            "The burnin is greater than or equal to the number of samples."
+            );
+
+    size_t n_kept = m_n_samples - burnin;
+    size_t n_rows = n_kept * m_n_chains;
+    res.resize(n_rows * n_cols);
+
+    // Transposing by blocks of rows, so both reads and writes stay in cache
+    const size_t block = 256u;
+    for (size_t c = 0u; c < m_n_chains; ++c)
+    {
+
+        const epiworld_double * src = x.data() +
+            (c * m_n_samples + burnin) * n_cols;
+        epiworld_double * dst = res.data() + c * n_kept;
+
+        for (size_t i0 = 0u; i0 < n_kept; i0 += block)
+        {
+            size_t i1 = std::min(i0 + block, n_kept);
+            for (size_t k = 0u; k < n_cols; ++k)
+                for (size_t i = i0; i < i1; ++i)
+                    dst[k * n_rows + i] = src[i * n_cols + k];
+        }
+
+    }
+
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_quantiles(
+    const std::vector< epiworld_double > & x,
+    size_t n_cols,
+    const std::vector< epiworld_double > & probs,
+    size_t burnin
+) const
+{
+
+    for (auto & p : probs)
+        if ((p < 0.0) || (p > 1.0))
+            throw std::range_error("Probabilities must be within [0, 1].");
+
+    std::vector< epiworld_double > cols;
+    get_columns(cols, x, n_cols, burnin);
+    size_t n = cols.size() / n_cols;
+
+    // Positions of the quantiles (partitioned in increasing order)
+    std::vector< size_t > pos(probs.size());
+    std::vector< size_t > order(probs.size());
+    for (size_t q = 0u; q < probs.size(); ++q)
+    {
+        pos[q] = std::min(
+            static_cast< size_t >(std::floor(probs[q] * n)), n - 1u
+            );
+        order[q] = q;
+    }
+
+    std::sort(order.begin(), order.end(), [&pos](size_t a, size_t b) {
+        return pos[a] < pos[b];
+    });
+
+    std::vector< epiworld_double > res(n_cols * probs.size());
+    for (size_t k = 0u; k < n_cols; ++k)
+    {
+
+        auto begin = cols.begin() + k * n;
+        auto first = begin;
+        for (auto q : order)
+        {
+            auto nth = begin + pos[q];
+            std::nth_element(first, nth, begin + n);
+            res[k * probs.size() + q] = *nth;
+            first = nth;
+        }
+
+    }
+
+    return res;
+
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_posterior_params(
+    size_t burnin
+) const
+{
+    std::vector< epiworld_double > res;
+    get_columns(res, m_all_accepted_params, m_n_params, burnin);
+    return res;
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_posterior_stats(
+    size_t burnin
+) const
+{
+    std::vector< epiworld_double > res;
+    get_columns(res, m_all_accepted_stats, m_n_stats, burnin);
+    return res;
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_quantiles_params(
+    const std::vector< epiworld_double > & probs,
+    size_t burnin
+) const
+{
+    return get_quantiles(m_all_accepted_params, m_n_params, probs, burnin);
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_quantiles_stats(
+    const std::vector< epiworld_double > & probs,
+    size_t burnin
+) const
+{
+    return get_quantiles(m_all_accepted_stats, m_n_stats, probs, burnin);
+}
+
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_stats_mad() const
+{
+
+    std::vector< epiworld_double > cols;
+    get_columns(cols, m_all_sample_stats, m_n_stats, 0u);
+    size_t n = cols.size() / m_n_stats;
+
+    std::vector< epiworld_double > res(m_n_stats);
     for (size_t k = 0u; k < m_n_stats; ++k)
     {
-        for (size_t i = 0u; i < m_n_samples; ++i)
-            res[k] += (this->m_all_accepted_stats[k + m_n_stats * i])/
-                static_cast< epiworld_double >(m_n_samples);
+
+        auto begin = cols.begin() + k * n;
+        auto mid   = begin + n / 2u;
+        std::nth_element(begin, mid, begin + n);
+        epiworld_double median = *mid;
+
+        for (auto it = begin; it != begin + n; ++it)
+            *it = std::abs(*it - median);
+
+        std::nth_element(begin, mid, begin + n);
+        res[k] = *mid;
+
     }
 
     return res;
 
 }
 
+template<typename TData>
+inline std::vector< epiworld_double > LFMCMC<TData>::get_distances(
+    const std::vector< epiworld_double > & stats,
+    const std::vector< epiworld_double > & scale
+) const
+{
+
+    size_t n_stats = m_observed_stats.size();
+    if ((n_stats == 0u) || (stats.size() % n_stats != 0u))
+        throw std::length_error(
+            "The size of the statistics is not a multiple of the number of observed statistics."
+            );
+
+    if ((scale.size() != 0u) && (scale.size() != n_stats))
+        throw std::length_error(
+            "The number of scales does not match the number of statistics."
+            );
+
+    std::vector< epiworld_double > inv_scale(scale.size());
+    for (size_t k = 0u; k < scale.size(); ++k)
+        inv_scale[k] = 1.0 / scale[k];
+
+    size_t n = stats.size() / n_stats;
+    std::vector< epiworld_double > res(n);
+    const epiworld_double * obs = m_observed_stats.data();
+    const epiworld_double * x = stats.data();
+
+    for (size_t i = 0u; i < n; ++i, x += n_stats)
+        res[i] = std::sqrt(
+            scale.size() == 0u ?
+                sq_dist_euclidean(x, obs, n_stats) :
+                sq_dist_scaled(x, obs, inv_scale.data(), n_stats)
+            );
+
+    return res;
+
+}
+
 template<typename TData>
 inline LFMCMC<TData> & LFMCMC<TData>::verbose_off()
 {
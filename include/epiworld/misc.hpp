@@ -205,12 +205,15 @@ inline int roulette(
     )
 {
 
-    if ((nelements * 2) > m->array_double_tmp.size())
+    // Thread-local buffer when the update is parallel
+    auto & tmp = m->get_array_double_tmp();
+
+    if ((nelements * 2) > tmp.size())
     {
         throw std::logic_error(
             "Trying to sample from more data than there is in roulette!" +
             std::to_string(nelements) + " vs " + 
-            std::to_string(m->array_double_tmp.size())
+            std::to_string(tmp.size())
             );
     }
 
@@ -220,10 +223,10 @@ inline int roulette(
     // std::vector< int > certain_infection;
     for (epiworld_fast_uint p = 0u; p < nelements; ++p)
     {
-        p_none *= (1.0 - m->array_double_tmp[p]);
+        p_none *= (1.0 - tmp[p]);
 
-        if (m->array_double_tmp[p] > (1 - 1e-100))
-            m->array_double_tmp[nelements + ncertain++] = p;
+        if (tmp[p] > (1 - 1e-100))
+            tmp[nelements + ncertain++] = p;
             // certain_infection.push_back(p);
         
     }
@@ -232,16 +235,16 @@ inline int roulette(
     // If there are one or more probs that go close to 1, sample
     // uniformly
     if (ncertain > 0u)
-        return m->array_double_tmp[nelements + std::floor(ncertain * r)]; //    certain_infection[std::floor(r * certain_infection.size())];
+        return tmp[nelements + std::floor(ncertain * r)]; //    certain_infection[std::floor(r * certain_infection.size())];
 
     // Step 2: Calculating the prob of none or single
     // std::vector< epiworld_double > probs_only_p;
     epiworld_double p_none_or_single = p_none;
     for (epiworld_fast_uint p = 0u; p < nelements; ++p)
     {
-        m->array_double_tmp[nelements + p] = 
-            m->array_double_tmp[p] * (p_none / (1.0 - m->array_double_tmp[p]));
-        p_none_or_single += m->array_double_tmp[nelements + p];
+        tmp[nelements + p] = 
+            tmp[p] * (p_none / (1.0 - tmp[p]));
+        p_none_or_single += tmp[nelements + p];
     }
 
     // Step 3: Roulette
@@ -252,7 +255,7 @@ inline int roulette(
     for (epiworld_fast_uint p = 0u; p < nelements; ++p)
     {
         // If it yield here, then bingo, the individual will acquire the disease
-        cumsum += m->array_double_tmp[nelements + p]/(p_none_or_single);
+        cumsum += tmp[nelements + p]/(p_none_or_single);
         if (r < cumsum)
             return static_cast<int>(p);
         
@@ -93,6 +93,10 @@ class Model {
     friend class AgentsSample<TSeq>;
     friend class DataBase<TSeq>;
     friend class Queue<TSeq>;
+    friend void default_add_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
+    friend void default_rm_virus<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
+    friend void default_add_tool<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
+    friend void default_rm_tool<TSeq>(Event<TSeq> & a, Model<TSeq> * m);
 protected:
 
     std::string name = ""; ///< Name of the model
@@ -102,7 +106,16 @@ protected:
     std::vector< Agent<TSeq> > population = {};
 
     bool using_backup = true;
-    std::vector< Agent<TSeq> > population_backup = {};
+
+    /**
+     * @brief Population and entities restored by `reset()`
+     * 
+     * @details Set once by `set_backup()` and never modified, so copies of
+     * the model (e.g., the threads of `run_multiple()`) share them. The
+     * working `population` (and its agents' entities and neighbors) is
+     * copied.
+     */
+    std::shared_ptr< const std::vector< Agent<TSeq> > > population_backup = nullptr;
 
     /**
      * @name Auxiliary variables for AgentsSample<TSeq> iterators
@@ -133,12 +146,70 @@ protected:
     ///@}
 
     bool directed = false;
+
+    /**
+     * @name Network in compressed sparse row (CSR) format
+     * 
+     * @details When `network_csr` is `true`, the network is owned by the
+     * model instead of the agents. The neighbors of agent `i` are stored in
+     * `network_targets` between `network_offsets[i]` and
+     * `network_offsets[i + 1] - 1`, and `network_locations` holds the position
+     * of agent `i` within each of its neighbors' slice (used for rewiring.)
+     * 
+     * The arrays are shared by copies of the model, so threads in
+     * `run_multiple()` hold a single copy of the network. Only rewiring
+     * modifies them, after `network_csr_unshare()` gives the model its own
+     * copy of the targets and locations (copy-on-write.) `reset()` points
+     * them back to the (shared) backup.
+     */
+    ///@{
+    bool network_csr = false;
+    std::shared_ptr< std::vector< size_t > > network_offsets =
+        std::make_shared< std::vector< size_t > >();
+    std::shared_ptr< std::vector< size_t > > network_targets =
+        std::make_shared< std::vector< size_t > >();
+    std::shared_ptr< std::vector< size_t > > network_locations =
+        std::make_shared< std::vector< size_t > >();
+    std::shared_ptr< std::vector< size_t > > network_targets_backup = nullptr;
+    std::shared_ptr< std::vector< size_t > > network_locations_backup = nullptr;
+
+    void network_csr_unshare();
+
+    void network_csr_build(
+        const std::vector< int > & source,
+        const std::vector< int > & target,
+        int size
+    );
+    ///@}
+
+    /**
+     * @name In-place reset
+     * 
+     * @details `network_modified` is set by `rewire()`,
+     * `Agent::add_neighbor()`, and `Agent::swap_neighbors()`, and cleared by
+     * `reset()` and `set_backup()`.
+     */
+    ///@{
+    bool reset_inplace = false;
+    bool network_modified = false;
+    ///@}
     
     std::vector< VirusPtr<TSeq> > viruses = {};
+
+    /**
+     * @brief Virus instances removed from agents, ready to be reused.
+     * 
+     * @details `default_rm_virus()` stores the instance here and
+     * `default_add_virus()` copies the new virus into it (instead of
+     * allocating a new one) if no one else holds a reference to it. This
+     * is not copied with the model, and it is cleared by `reset()`, so it
+     * holds at most as many instances as infected agents in a run.
+     */
+    std::vector< VirusPtr<TSeq> > viruses_pool = {};
     std::vector< ToolPtr<TSeq> > tools = {};
 
     std::vector< Entity<TSeq> > entities = {}; 
-    std::vector< Entity<TSeq> > entities_backup = {};
+    std::shared_ptr< const std::vector< Entity<TSeq> > > entities_backup = nullptr;
 
     std::shared_ptr< std::mt19937 > engine = std::make_shared< std::mt19937 >();
     
@@ -199,6 +270,8 @@ protected:
     Queue<TSeq> queue;
     bool use_queuing   = true;
 
+    bool run_multiple_dynamic = false; ///< Dynamic scheduling in `run_multiple()`.
+
     /**
      * @brief Variables used to keep track of the events
      * to be made regarding viruses.
@@ -206,6 +279,76 @@ protected:
     std::vector< Event<TSeq> > events = {};
     epiworld_fast_uint nactions = 0u;
 
+    /**
+     * @brief Functions of the queued custom events (see `Event::idx_call`.)
+     * Cleared by `events_run()`.
+     */
+    std::vector< EventFun<TSeq> > events_calls = {};
+
+    /**
+     * @name Parallel update of the agents' states
+     * 
+     * @details When `update_nthreads > 1` (see `update_parallel_on()`), the
+     * population is split into contiguous blocks, one per thread. During
+     * the update, each thread draws random numbers from its own engine
+     * (seeded from the model's engine at every step,) uses its own
+     * temporary arrays, and stores its events in its own buffer. The
+     * buffers are then applied in agent id order by `events_run()`.
+     */
+    ///@{
+    int update_nthreads = 1;
+    bool update_parallel_active = false;
+    std::vector< std::vector< Event<TSeq> > > events_threads = {};
+    std::vector< epiworld_fast_uint > nactions_threads = {};
+    std::vector< std::vector< EventFun<TSeq> > > events_calls_threads = {};
+    std::vector< std::mt19937 > engine_threads = {};
+    std::vector< std::vector< epiworld_double > > array_double_tmp_threads = {};
+    std::vector< std::vector< Virus<TSeq> * > > array_virus_tmp_threads = {};
+    void update_state_parallel();
+    ///@}
+
+    /**
+     * @name Counter-based random number streams
+     * 
+     * @details When `rng_counter` is true (see `rng_counter_on()`), the
+     * random numbers are drawn from a `Philox4x32` engine keyed by
+     * `rng_counter_seed`. Before an agent is updated (or mutated,) the
+     * engine is moved to the stream `(agent id, date, phase)`, so each
+     * draw is a function of the seed, the date, the agent, and the draw
+     * index only. The remaining draws of the day (e.g., events, global
+     * events, and rewiring) use the stream `(0, date, RNG_PHASE_MODEL)`,
+     * and `reset()` uses `(0, 0, RNG_PHASE_RESET)`.
+     */
+    ///@{
+    bool rng_counter = false;
+    uint64_t rng_counter_seed = 0u;
+    Philox4x32 engine_counter;
+    std::vector< Philox4x32 > engine_counter_threads = {};
+    static const uint32_t RNG_PHASE_UPDATE   = 0u;
+    static const uint32_t RNG_PHASE_MUTATION = 1u;
+    static const uint32_t RNG_PHASE_MODEL    = 2u;
+    static const uint32_t RNG_PHASE_RESET    = 3u;
+    void rng_counter_stream(size_t agent_id, uint32_t phase);
+    ///@}
+
+    /**
+     * @brief Draws from `dist` using the model's engine (or the thread's
+     * engine during a parallel update.)
+     * 
+     * @param dist Distribution.
+     * @param par Parameters of the distribution to use for this draw.
+     */
+    ///@{
+    template<typename TDist>
+    typename TDist::result_type rdraw(TDist & dist);
+
+    template<typename TDist>
+    typename TDist::result_type rdraw(
+        TDist & dist,
+        const typename TDist::param_type & par
+    );
+    ///@}
+
     /**
      * @brief Construct a new Event object
      * 
@@ -214,11 +357,13 @@ protected:
      * @param tool_ Tool pointer included in the action
      * @param entity_ Entity pointer included in the action
      * @param new_state_ New state of the agent
-     * @param call_ Function the action will call
+     * @param call_ Function the action will call (stored by the model.)
+     * @param type_ Built-in event type.
      * @param queue_ Change in the queue
      * @param idx_agent_ Location of agent in object.
      * @param idx_object_ Location of object in agent.
      */
+    ///@{
     void events_add(
         Agent<TSeq> * agent_,
         VirusPtr<TSeq> virus_,
@@ -231,6 +376,25 @@ protected:
         int idx_object_
         );
 
+    void events_add(
+        Agent<TSeq> * agent_,
+        VirusPtr<TSeq> virus_,
+        ToolPtr<TSeq> tool_,
+        Entity<TSeq> * entity_,
+        epiworld_fast_int new_state_,
+        epiworld_fast_int queue_,
+        EventType type_,
+        int idx_agent_,
+        int idx_object_
+        );
+    ///@}
+
+    /**
+     * @brief Next free event in the buffer (the thread's buffer during a
+     * parallel update.)
+     */
+    Event<TSeq> & events_next();
+
     /**
      * @name Tool Mixers
      * 
@@ -245,6 +409,31 @@ protected:
     MixerFun<TSeq> recovery_enhancer_mixer = recovery_enhancer_mixer_default<TSeq>;
     MixerFun<TSeq> death_reduction_mixer = death_reduction_mixer_default<TSeq>;
 
+    /**
+     * @name Cached tool effects
+     * 
+     * @details When `tool_effects_cache` is `true`, the output of the mixers
+     * is stored in `tool_effects` for each (agent, virus id, effect), where
+     * the effect is one of `TOOL_EFFECT_*`. Entries are computed on first
+     * use and flagged in `tool_effects_valid`. During a parallel update, the
+     * cache is only read (missing entries are computed but not stored.)
+     */
+    ///@{
+    bool tool_effects_cache = false;
+    std::vector< epiworld_double > tool_effects = {};
+    std::vector< unsigned char > tool_effects_valid = {};
+    static const size_t TOOL_EFFECT_SUSCEPTIBILITY = 0u;
+    static const size_t TOOL_EFFECT_TRANSMISSION   = 1u;
+    static const size_t TOOL_EFFECT_RECOVERY       = 2u;
+    static const size_t TOOL_EFFECT_DEATH          = 3u;
+    epiworld_double tool_effect(
+        Agent<TSeq> * p,
+        const VirusPtr<TSeq> & v,
+        size_t effect
+    );
+    void tool_effects_invalidate(size_t agent_id);
+    ///@}
+
     /**
      * @brief Advanced usage: Makes a copy of data and returns it as undeleted pointer
      * 
@@ -258,6 +447,18 @@ public:
     std::vector<epiworld_double> array_double_tmp;
     std::vector<Virus<TSeq> * > array_virus_tmp;
 
+    /**
+     * @name Temporary arrays
+     * 
+     * @details Scratch space used by samplers (e.g., `roulette()`.) During
+     * a parallel update each thread has its own arrays, so update functions
+     * should access them through these functions.
+     */
+    ///@{
+    std::vector< epiworld_double > & get_array_double_tmp();
+    std::vector< Virus<TSeq> * > & get_array_virus_tmp();
+    ///@}
+
     Model();
     Model(const Model<TSeq> & m);
     Model(Model<TSeq> & m);
@@ -420,6 +621,56 @@ public:
     void agents_empty_graph(epiworld_fast_uint n = 1000);
     ///@}
 
+    /**
+     * @name Network storage
+     * 
+     * @details By default, each agent stores its neighbors in its own
+     * vectors. With `network_csr_on()`, the model stores the whole network in
+     * two contiguous arrays (CSR format,) which reduces memory usage and
+     * makes iterating over neighbors cache-friendly. `agents_from_adjlist()`,
+     * `agents_from_edgelist()`, and `agents_smallworld()` build the CSR arrays
+     * directly. If the agents already have a network, it is converted
+     * (preserving the order of the neighbors.) Agents in a CSR network cannot
+     * add neighbors one at a time (see `Agent::add_neighbor()`.)
+     * 
+     * The CSR arrays are shared (read-only) by copies of the model, such as
+     * the threads of `run_multiple()`; a copy only gets its own targets and
+     * locations if it rewires. Networks stored in the agents are copied with
+     * them.
+     */
+    ///@{
+    Model<TSeq> & network_csr_on(); ///< Stores the network in CSR format.
+    Model<TSeq> & network_csr_off(); ///< Stores the network in the agents (default.)
+    bool is_network_csr() const; ///< Query if the network is stored in CSR format.
+    const std::vector< size_t > & get_network_offsets() const;
+    const std::vector< size_t > & get_network_targets() const;
+    ///@}
+
+    /**
+     * @name Network snapshots
+     * 
+     * @details `write_network_snapshot()` saves the built topology (the
+     * neighbors of each agent, their locations, and the agents' entities)
+     * to a binary file, and `agents_from_network_snapshot()` loads it back
+     * with a single read, skipping the construction of the network (works
+     * with either network storage.) If the model already has agents, the
+     * snapshot must match their number and the directedness of the model.
+     * Entity memberships are loaded with `load_agents_entities_ties()`, so
+     * the entities must be added to the model first.
+     * 
+     * The file starts with the magic string `EPIWNETS` and a format version
+     * (uint32,) followed by the number of agents, a directed flag, the number
+     * of ties, and the number of memberships; then the CSR offsets (uint64,)
+     * targets and locations (uint32,) and the agent and entity ids of each
+     * membership (uint32.) All numbers are little-endian.
+     * 
+     * @param fn Path to the file.
+     */
+    ///@{
+    void write_network_snapshot(std::string fn) const;
+    void agents_from_network_snapshot(std::string fn);
+    ///@}
+
     /**
      * @name Functions to run the model
      * 
@@ -428,6 +679,14 @@ public:
      * @param fun In the case of `run_multiple`, a function that is called
      * after each experiment.
      * 
+     * @details With `nthreads > 1`, `run_multiple()` runs the replicates on
+     * copies of the model (see `clone_ptr()`.) The copies share only the
+     * backups restored by `reset()` (population and entities) and, with
+     * `network_csr_on()`, the network. Everything else is copied once per
+     * thread, including the population with each agent's entities,
+     * neighbors (unless the network is in CSR format,) viruses, and tools,
+     * as well as the database, so each thread holds about one copy of the
+     * population.
      */
     ///@{
     void update_state();
@@ -448,6 +707,23 @@ public:
         );
     ///@}
 
+    /**
+     * @name Scheduling of `run_multiple()`
+     * 
+     * @details By default, `run_multiple()` splits the replicates into
+     * contiguous blocks, one per thread. With `run_multiple_dynamic_on()`,
+     * threads instead take the next pending replicate as soon as they are
+     * done, which avoids idle threads when the replicates' run times vary
+     * (e.g., early die-outs vs. full epidemics.) Each replicate keeps its
+     * seed, so the results are the same under both schedules (only the
+     * order in which `fun` is called changes.)
+     */
+    ///@{
+    Model<TSeq> & run_multiple_dynamic_on();
+    Model<TSeq> & run_multiple_dynamic_off();
+    bool is_run_multiple_dynamic_on() const;
+    ///@}
+
     size_t get_n_viruses() const; ///< Number of viruses in the model
     size_t get_n_tools() const; ///< Number of tools in the model
     epiworld_fast_uint get_ndays() const;
@@ -500,6 +776,19 @@ public:
         std::string fn_generation_time
         ) const;
 
+    /**
+     * @brief Wrapper of `DataBase::write_data_binary`
+     */
+    void write_data_binary(
+        std::string fn_virus_hist,
+        std::string fn_tool_hist,
+        std::string fn_total_hist,
+        std::string fn_transmission,
+        std::string fn_transition,
+        std::string fn_reproductive_number,
+        std::string fn_generation_time
+        ) const;
+
     /**
      * @name Export the network data in edgelist form
      * 
@@ -535,6 +824,22 @@ public:
      * 
      */
     virtual void reset();
+
+    /**
+     * @name In-place reset
+     * 
+     * @details By default, `reset()` restores the population and the entities
+     * by copying their backups. With `reset_inplace_on()`, agents and entities
+     * are reset in place (state, virus, tools, and entities), and the
+     * population backup is copied only if the network was modified during
+     * the last run (e.g., by `rewire()`.) Use it only when the simulation does
+     * not modify agents or entities in other ways.
+     */
+    ///@{
+    Model<TSeq> & reset_inplace_on(); ///< Resets agents in place.
+    Model<TSeq> & reset_inplace_off(); ///< Copies the backups (default.)
+    bool is_reset_inplace_on() const;
+    ///@}
     const Model<TSeq> & print(bool lite = false) const;
 
     /**
@@ -683,6 +988,42 @@ public:
     Queue<TSeq> & get_queue(); ///< Retrieve the `Queue` object.
     ///@}
 
+    /**
+     * @name Parallel update of the agents' states
+     * 
+     * @details With `update_parallel_on()`, `update_state()` splits the
+     * agents across `nthreads` threads (requires OpenMP, otherwise the
+     * update is serial.) Update functions must only modify the model
+     * through events (e.g., `Agent::change_state()`, `Agent::set_virus()`),
+     * and use the model's random number generators and temporary arrays
+     * (`get_array_double_tmp()`, `get_array_virus_tmp()`.) Results are
+     * reproducible for a given number of threads.
+     * 
+     * @param nthreads Number of threads.
+     */
+    ///@{
+    Model<TSeq> & update_parallel_on(int nthreads);
+    Model<TSeq> & update_parallel_off();
+    bool is_update_parallel_on() const;
+    ///@}
+
+    /**
+     * @name Counter-based random number streams
+     * 
+     * @details With `rng_counter_on()`, the model draws its random numbers
+     * from a counter-based engine (`Philox4x32`) instead of the
+     * `std::mt19937` engine. Each agent gets its own stream every day,
+     * identified by the seed, the date, and the agent id, so the results
+     * are identical regardless of the number of threads used by
+     * `update_parallel_on()` or the order in which agents are updated.
+     * Update functions don't need to change.
+     */
+    ///@{
+    Model<TSeq> & rng_counter_on();
+    Model<TSeq> & rng_counter_off();
+    bool is_rng_counter_on() const;
+    ///@}
+
     /**
      * @name Get the susceptibility reduction object
      * 
@@ -696,6 +1037,24 @@ public:
     void set_death_reduction_mixer(MixerFun<TSeq> fun);
     ///@}
 
+    /**
+     * @name Cached tool effects
+     * 
+     * @details With `tool_effects_cache_on()`, the combined effect of each
+     * agent's tools (as returned by the mixers) is computed once per virus
+     * and reused until the agent gains or loses a tool. The whole cache is
+     * cleared on `reset()`, `set_param()`, `read_params()`, and when a mixer
+     * is replaced. Effects must depend on the virus only through its id,
+     * and not on the date. If parameters are modified through
+     * `operator()`, call `tool_effects_cache_invalidate()`.
+     */
+    ///@{
+    Model<TSeq> & tool_effects_cache_on(); ///< Caches the tools' effects.
+    Model<TSeq> & tool_effects_cache_off(); ///< Calls the mixers every time (default.)
+    bool is_tool_effects_cache_on() const;
+    void tool_effects_cache_invalidate(); ///< Clears the cache.
+    ///@}
+
     const std::vector< VirusPtr<TSeq> > & get_viruses() const;
     const std::vector< ToolPtr<TSeq> > & get_tools() const;
     Virus<TSeq> & get_virus(size_t id);
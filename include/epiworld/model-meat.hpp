@@ -149,6 +149,33 @@ inline std::function<void(size_t,Model<TSeq>*)> make_save_run(
 }
 
 
+template<typename TSeq>
+inline Event<TSeq> & Model<TSeq>::events_next()
+{
+
+    // During a parallel update, each thread has its own buffer
+    std::vector< Event<TSeq> > & events = update_parallel_active ?
+        events_threads[EPI_GET_THREAD_ID()] : this->events;
+
+    epiworld_fast_uint & nactions = update_parallel_active ?
+        nactions_threads[EPI_GET_THREAD_ID()] : this->nactions;
+
+    ++nactions;
+
+    #ifdef EPI_DEBUG
+    if (nactions == 0)
+        throw std::logic_error("Events cannot be zero!!");
+    #endif
+
+    if (nactions > events.size())
+        events.emplace_back(
+            nullptr, nullptr, nullptr, nullptr, 0, 0, -1, -1
+        );
+
+    return events[nactions - 1u];
+
+}
+
 template<typename TSeq>
 inline void Model<TSeq>::events_add(
     Agent<TSeq> * agent_,
@@ -162,39 +189,60 @@ inline void Model<TSeq>::events_add(
     int idx_object_
 ) {
 
-    ++nactions;
+    Event<TSeq> & A = events_next();
 
-    #ifdef EPI_DEBUG
-    if (nactions == 0)
-        throw std::logic_error("Events cannot be zero!!");
-    #endif
+    A.agent      = agent_;
+    A.virus      = std::move(virus_);
+    A.tool       = std::move(tool_);
+    A.entity     = entity_;
+    A.new_state  = new_state_;
+    A.queue      = queue_;
+    A.idx_agent  = idx_agent_;
+    A.idx_object = idx_object_;
+    A.type       = EventType::custom;
+    A.idx_call   = -1;
 
-    if (nactions > events.size())
+    if (call_)
     {
 
-        events.emplace_back(
-            Event<TSeq>(
-                agent_, virus_, tool_, entity_, new_state_, queue_, call_,
-                idx_agent_, idx_object_
-            ));
+        // During a parallel update, each thread has its own functions
+        std::vector< EventFun<TSeq> > & calls = update_parallel_active ?
+            events_calls_threads[EPI_GET_THREAD_ID()] : events_calls;
+
+        A.idx_call = static_cast< int >(calls.size());
+        calls.push_back(std::move(call_));
 
     }
-    else 
-    {
 
-        Event<TSeq> & A = events.at(nactions - 1u);
+    return;
 
-        A.agent      = agent_;
-        A.virus      = virus_;
-        A.tool       = tool_;
-        A.entity     = entity_;
-        A.new_state  = new_state_;
-        A.queue      = queue_;
-        A.call       = call_;
-        A.idx_agent  = idx_agent_;
-        A.idx_object = idx_object_;
+}
 
-    }
+template<typename TSeq>
+inline void Model<TSeq>::events_add(
+    Agent<TSeq> * agent_,
+    VirusPtr<TSeq> virus_,
+    ToolPtr<TSeq> tool_,
+    Entity<TSeq> * entity_,
+    epiworld_fast_int new_state_,
+    epiworld_fast_int queue_,
+    EventType type_,
+    int idx_agent_,
+    int idx_object_
+) {
+
+    Event<TSeq> & A = events_next();
+
+    A.agent      = agent_;
+    A.virus      = std::move(virus_);
+    A.tool       = std::move(tool_);
+    A.entity     = entity_;
+    A.new_state  = new_state_;
+    A.queue      = queue_;
+    A.idx_agent  = idx_agent_;
+    A.idx_object = idx_object_;
+    A.type       = type_;
+    A.idx_call   = -1;
 
     return;
 
@@ -236,9 +284,33 @@ inline void Model<TSeq>::events_run()
         // Applying function after the fact. This way, if there were
         // updates, they can be recorded properly, before losing the information
         p->state = a.new_state;
-        if (a.call)
+        switch (a.type)
         {
-            a.call(a, this);
+        case EventType::add_virus:
+            default_add_virus<TSeq>(a, this);
+            break;
+        case EventType::rm_virus:
+            default_rm_virus<TSeq>(a, this);
+            break;
+        case EventType::add_tool:
+            default_add_tool<TSeq>(a, this);
+            break;
+        case EventType::rm_tool:
+            default_rm_tool<TSeq>(a, this);
+            break;
+        case EventType::add_entity:
+            default_add_entity<TSeq>(a, this);
+            break;
+        case EventType::rm_entity:
+            default_rm_entity<TSeq>(a, this);
+            break;
+        case EventType::change_state:
+            default_change_state<TSeq>(a, this);
+            break;
+        case EventType::custom:
+            if (a.idx_call >= 0)
+                events_calls[a.idx_call](a, this);
+            break;
         }
 
         // Registering that the last change was today
@@ -260,9 +332,9 @@ inline void Model<TSeq>::events_run()
             else if (a.queue == -Queue<TSeq>::Everyone)
                 queue -= p;
             else if (a.queue == Queue<TSeq>::OnlySelf)
-                queue[p->get_id()]++;
+                queue.active_add(p->get_id());
             else if (a.queue == -Queue<TSeq>::OnlySelf)
-                queue[p->get_id()]--;
+                queue.active_rm(p->get_id());
             else if (a.queue != Queue<TSeq>::NoOne)
                 throw std::logic_error(
                     "The proposed queue change is not valid. Queue values can be {-2, -1, 0, 1, 2}."
@@ -274,6 +346,7 @@ inline void Model<TSeq>::events_run()
 
     // Go back to square 1
     nactions = 0u;
+    events_calls.clear();
 
     return;
     
@@ -380,6 +453,14 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     population(model.population),
     population_backup(model.population_backup),
     directed(model.directed),
+    network_csr(model.network_csr),
+    network_offsets(model.network_offsets),
+    network_targets(model.network_targets),
+    network_locations(model.network_locations),
+    network_targets_backup(model.network_targets_backup),
+    network_locations_backup(model.network_locations_backup),
+    reset_inplace(model.reset_inplace),
+    network_modified(model.network_modified),
     viruses(model.viruses),
     tools(model.tools),
     entities(model.entities),
@@ -398,6 +479,18 @@ inline Model<TSeq>::Model(const Model<TSeq> & model) :
     globalevents(model.globalevents),
     queue(model.queue),
     use_queuing(model.use_queuing),
+    run_multiple_dynamic(model.run_multiple_dynamic),
+    update_nthreads(model.update_nthreads),
+    rng_counter(model.rng_counter),
+    rng_counter_seed(model.rng_counter_seed),
+    engine_counter(model.engine_counter),
+    susceptibility_reduction_mixer(model.susceptibility_reduction_mixer),
+    transmission_reduction_mixer(model.transmission_reduction_mixer),
+    recovery_enhancer_mixer(model.recovery_enhancer_mixer),
+    death_reduction_mixer(model.death_reduction_mixer),
+    tool_effects_cache(model.tool_effects_cache),
+    tool_effects(model.tool_effects),
+    tool_effects_valid(model.tool_effects_valid),
     array_double_tmp(model.array_double_tmp.size()),
     array_virus_tmp(model.array_virus_tmp.size())
 {
@@ -433,6 +526,15 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     agents_data(std::move(model.agents_data)),
     agents_data_ncols(std::move(model.agents_data_ncols)),
     directed(std::move(model.directed)),
+    // Network (CSR)
+    network_csr(model.network_csr),
+    network_offsets(std::move(model.network_offsets)),
+    network_targets(std::move(model.network_targets)),
+    network_locations(std::move(model.network_locations)),
+    network_targets_backup(std::move(model.network_targets_backup)),
+    network_locations_backup(std::move(model.network_locations_backup)),
+    reset_inplace(model.reset_inplace),
+    network_modified(model.network_modified),
     // Virus
     viruses(std::move(model.viruses)),
     // Tools
@@ -463,6 +565,20 @@ inline Model<TSeq>::Model(Model<TSeq> && model) :
     globalevents(std::move(model.globalevents)),
     queue(std::move(model.queue)),
     use_queuing(model.use_queuing),
+    run_multiple_dynamic(model.run_multiple_dynamic),
+    update_nthreads(model.update_nthreads),
+    rng_counter(model.rng_counter),
+    rng_counter_seed(model.rng_counter_seed),
+    engine_counter(model.engine_counter),
+    susceptibility_reduction_mixer(
+        std::move(model.susceptibility_reduction_mixer)
+    ),
+    transmission_reduction_mixer(std::move(model.transmission_reduction_mixer)),
+    recovery_enhancer_mixer(std::move(model.recovery_enhancer_mixer)),
+    death_reduction_mixer(std::move(model.death_reduction_mixer)),
+    tool_effects_cache(model.tool_effects_cache),
+    tool_effects(std::move(model.tool_effects)),
+    tool_effects_valid(std::move(model.tool_effects_valid)),
     array_double_tmp(model.array_double_tmp.size()),
     array_virus_tmp(model.array_virus_tmp.size())
 {
@@ -491,6 +607,16 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     db.user_data.model = this;
 
     directed = m.directed;
+
+    network_csr              = m.network_csr;
+    network_offsets          = m.network_offsets;
+    network_targets          = m.network_targets;
+    network_locations        = m.network_locations;
+    network_targets_backup   = m.network_targets_backup;
+    network_locations_backup = m.network_locations_backup;
+
+    reset_inplace    = m.reset_inplace;
+    network_modified = m.network_modified;
     
     viruses                        = m.viruses;
 
@@ -520,6 +646,23 @@ inline Model<TSeq> & Model<TSeq>::operator=(const Model<TSeq> & m)
     queue       = m.queue;
     use_queuing = m.use_queuing;
 
+    run_multiple_dynamic = m.run_multiple_dynamic;
+
+    update_nthreads = m.update_nthreads;
+
+    rng_counter      = m.rng_counter;
+    rng_counter_seed = m.rng_counter_seed;
+    engine_counter   = m.engine_counter;
+
+    susceptibility_reduction_mixer = m.susceptibility_reduction_mixer;
+    transmission_reduction_mixer   = m.transmission_reduction_mixer;
+    recovery_enhancer_mixer        = m.recovery_enhancer_mixer;
+    death_reduction_mixer          = m.death_reduction_mixer;
+
+    tool_effects_cache = m.tool_effects_cache;
+    tool_effects       = m.tool_effects;
+    tool_effects_valid = m.tool_effects_valid;
+
     // Making sure population is passed correctly
     // Pointing to the right place
     db.model = this;
@@ -656,10 +799,639 @@ inline void Model<TSeq>::agents_empty_graph(
         p.id = i++;
         p.model = this;
     }
+
+    // An empty network in CSR format
+    network_offsets   = std::make_shared< std::vector< size_t > >();
+    network_targets   = std::make_shared< std::vector< size_t > >();
+    network_locations = std::make_shared< std::vector< size_t > >();
+    network_targets_backup   = nullptr;
+    network_locations_backup = nullptr;
+
+    if (network_csr)
+        network_offsets->resize(n + 1, 0u);
     
 
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::network_csr_build(
+    const std::vector< int > & source,
+    const std::vector< int > & target,
+    int size
+)
+{
+
+    if (source.size() != target.size())
+        throw std::length_error(
+            "The source (" + std::to_string(source.size()) +
+            ") and target (" + std::to_string(target.size()) +
+            ") vectors must have the same length."
+        );
+
+    int max_id = size - 1;
+    for (size_t m = 0u; m < source.size(); ++m)
+    {
+
+        if ((source[m] < 0) || (source[m] > max_id))
+            throw std::range_error(
+                "The source["+std::to_string(m)+"] = " + std::to_string(source[m]) +
+                " is out of range [0, " + std::to_string(max_id) + "]"
+                );
+
+        if ((target[m] < 0) || (target[m] > max_id))
+            throw std::range_error(
+                "The target["+std::to_string(m)+"] = " + std::to_string(target[m]) +
+                " is out of range [0, " + std::to_string(max_id) + "]"
+                );
+
+    }
+
+    // Creating the agents (this also resets the offsets)
+    agents_empty_graph(static_cast< epiworld_fast_uint >(size));
+
+    // Counting degrees. As in Agent::add_neighbor(), ties are always
+    // added in both directions.
+    auto & offsets   = *network_offsets;
+    auto & targets   = *network_targets;
+    auto & locations = *network_locations;
+    for (size_t m = 0u; m < source.size(); ++m)
+    {
+        ++offsets[source[m] + 1];
+        ++offsets[target[m] + 1];
+    }
+
+    for (int i = 0; i < size; ++i)
+        offsets[i + 1] += offsets[i];
+
+    // Filling the targets
+    targets.resize(offsets[size]);
+    std::vector< size_t > cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t m = 0u; m < source.size(); ++m)
+    {
+        targets[cursor[source[m]]++] = static_cast< size_t >(target[m]);
+        targets[cursor[target[m]]++] = static_cast< size_t >(source[m]);
+    }
+
+    // Sorting each slice and removing duplicated ties. Since slices
+    // only shrink, they can be compacted in place.
+    size_t nties = 0u;
+    for (int i = 0; i < size; ++i)
+    {
+
+        auto first = targets.begin() + offsets[i];
+        auto last  = targets.begin() + offsets[i + 1];
+
+        std::sort(first, last);
+        last = std::unique(first, last);
+
+        offsets[i] = nties;
+        for (auto it = first; it != last; ++it)
+            targets[nties++] = *it;
+
+    }
+
+    offsets[size] = nties;
+    targets.resize(nties);
+    targets.shrink_to_fit();
+
+    // Position of each agent within its neighbors' slice
+    locations.resize(nties);
+    for (int i = 0; i < size; ++i)
+    {
+
+        for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+        {
+
+            auto first = targets.begin() + offsets[targets[k]];
+            auto last  = targets.begin() + offsets[targets[k] + 1];
+
+            locations[k] = static_cast< size_t >(
+                std::lower_bound(first, last, static_cast< size_t >(i)) - first
+            );
+
+        }
+
+        population[i].n_neighbors = offsets[i + 1] - offsets[i];
+
+    }
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::network_csr_on()
+{
+
+    if (network_csr)
+        return *this;
+
+    if ((population_backup != nullptr) && population_backup->size())
+        throw std::logic_error(
+            "The network storage cannot be changed after -set_backup()- was called."
+        );
+
+    network_csr = true;
+
+    // Moving the existing network (if any) to new CSR arrays (the current
+    // ones may be shared with copies of the model)
+    this->network_offsets   = std::make_shared< std::vector< size_t > >();
+    this->network_targets   = std::make_shared< std::vector< size_t > >();
+    this->network_locations = std::make_shared< std::vector< size_t > >();
+    auto & network_offsets   = *this->network_offsets;
+    auto & network_targets   = *this->network_targets;
+    auto & network_locations = *this->network_locations;
+    network_offsets.assign(population.size() + 1, 0u);
+    for (const auto & p : population)
+        network_offsets[p.id + 1] = p.n_neighbors;
+
+    for (size_t i = 0u; i < population.size(); ++i)
+        network_offsets[i + 1] += network_offsets[i];
+
+    network_targets.resize(network_offsets.back());
+    network_locations.resize(network_offsets.back());
+
+    for (auto & p : population)
+    {
+
+        if (p.neighbors == nullptr)
+            continue;
+
+        std::copy(
+            p.neighbors->begin(), p.neighbors->end(),
+            network_targets.begin() + network_offsets[p.id]
+        );
+
+        std::copy(
+            p.neighbors_locations->begin(), p.neighbors_locations->end(),
+            network_locations.begin() + network_offsets[p.id]
+        );
+
+        delete p.neighbors;
+        delete p.neighbors_locations;
+
+        p.neighbors = nullptr;
+        p.neighbors_locations = nullptr;
+
+    }
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::network_csr_off()
+{
+
+    if (!network_csr)
+        return *this;
+
+    if ((population_backup != nullptr) && population_backup->size())
+        throw std::logic_error(
+            "The network storage cannot be changed after -set_backup()- was called."
+        );
+
+    // Giving each agent its own copy of the neighbors
+    auto & network_offsets   = *this->network_offsets;
+    auto & network_targets   = *this->network_targets;
+    auto & network_locations = *this->network_locations;
+    for (auto & p : population)
+    {
+
+        if (p.n_neighbors == 0u)
+            continue;
+
+        auto first = network_offsets[p.id];
+        auto last  = network_offsets[p.id + 1];
+
+        p.neighbors = new std::vector< size_t >(
+            network_targets.begin() + first, network_targets.begin() + last
+        );
+
+        p.neighbors_locations = new std::vector< size_t >(
+            network_locations.begin() + first, network_locations.begin() + last
+        );
+
+    }
+
+    network_csr = false;
+    this->network_offsets   = std::make_shared< std::vector< size_t > >();
+    this->network_targets   = std::make_shared< std::vector< size_t > >();
+    this->network_locations = std::make_shared< std::vector< size_t > >();
+    network_targets_backup   = nullptr;
+    network_locations_backup = nullptr;
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_network_csr() const
+{
+    return network_csr;
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::reset_inplace_on()
+{
+    reset_inplace = true;
+    return *this;
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::reset_inplace_off()
+{
+    reset_inplace = false;
+    return *this;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_reset_inplace_on() const
+{
+    return reset_inplace;
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::set_susceptibility_reduction_mixer(MixerFun<TSeq> fun)
+{
+    susceptibility_reduction_mixer = fun;
+    tool_effects_cache_invalidate();
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::set_transmission_reduction_mixer(MixerFun<TSeq> fun)
+{
+    transmission_reduction_mixer = fun;
+    tool_effects_cache_invalidate();
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::set_recovery_enhancer_mixer(MixerFun<TSeq> fun)
+{
+    recovery_enhancer_mixer = fun;
+    tool_effects_cache_invalidate();
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::set_death_reduction_mixer(MixerFun<TSeq> fun)
+{
+    death_reduction_mixer = fun;
+    tool_effects_cache_invalidate();
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::tool_effects_cache_on()
+{
+    tool_effects_cache = true;
+    tool_effects_cache_invalidate();
+    return *this;
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::tool_effects_cache_off()
+{
+    tool_effects_cache = false;
+    tool_effects.clear();
+    tool_effects_valid.clear();
+    return *this;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_tool_effects_cache_on() const
+{
+    return tool_effects_cache;
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::tool_effects_cache_invalidate()
+{
+
+    if (!tool_effects_cache)
+        return;
+
+    size_t n = population.size() * viruses.size() * 4u;
+    tool_effects.resize(n);
+    tool_effects_valid.assign(n, 0u);
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::tool_effects_invalidate(size_t agent_id)
+{
+
+    if (!tool_effects_cache || tool_effects_valid.empty())
+        return;
+
+    auto first = tool_effects_valid.begin() + agent_id * viruses.size() * 4u;
+    std::fill(first, first + viruses.size() * 4u, 0u);
+
+}
+
+template<typename TSeq>
+inline epiworld_double Model<TSeq>::tool_effect(
+    Agent<TSeq> * p,
+    const VirusPtr<TSeq> & v,
+    size_t effect
+)
+{
+
+    MixerFun<TSeq> * mixer;
+    switch (effect)
+    {
+    case TOOL_EFFECT_SUSCEPTIBILITY: mixer = &susceptibility_reduction_mixer; break;
+    case TOOL_EFFECT_TRANSMISSION:   mixer = &transmission_reduction_mixer; break;
+    case TOOL_EFFECT_RECOVERY:       mixer = &recovery_enhancer_mixer; break;
+    default:                         mixer = &death_reduction_mixer;
+    }
+
+    // Viruses not registered in the model (or a cache built for another
+    // population) are not cached
+    int virus_id = v->get_id();
+    size_t nviruses = viruses.size();
+    if (
+        (virus_id < 0) || (static_cast< size_t >(virus_id) >= nviruses) ||
+        (tool_effects_valid.size() != population.size() * nviruses * 4u)
+    )
+        return (*mixer)(p, v, this);
+
+    size_t k = (
+        static_cast< size_t >(p->get_id()) * nviruses +
+        static_cast< size_t >(virus_id)
+        ) * 4u + effect;
+
+    if (tool_effects_valid[k])
+        return tool_effects[k];
+
+    epiworld_double res = (*mixer)(p, v, this);
+
+    // Threads only read the cache
+    if (!update_parallel_active)
+    {
+        tool_effects[k]       = res;
+        tool_effects_valid[k] = 1u;
+    }
+
+    return res;
+
+}
+
+template<typename TSeq>
+inline const std::vector< size_t > & Model<TSeq>::get_network_offsets() const
+{
+    return *network_offsets;
+}
+
+template<typename TSeq>
+inline const std::vector< size_t > & Model<TSeq>::get_network_targets() const
+{
+    return *network_targets;
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::network_csr_unshare()
+{
+
+    if (network_targets.use_count() > 1)
+        network_targets = std::make_shared< std::vector< size_t > >(
+            *network_targets
+        );
+
+    if (network_locations.use_count() > 1)
+        network_locations = std::make_shared< std::vector< size_t > >(
+            *network_locations
+        );
+
+}
+
+#define EPI_SNAPSHOT_VERSION 1u
+
+template<typename TSeq>
+inline void Model<TSeq>::write_network_snapshot(std::string fn) const
+{
+
+    size_t n = population.size();
+    if (n > static_cast< size_t >(std::numeric_limits< uint32_t >::max()))
+        throw std::range_error(
+            "Network snapshots support up to 2^32 - 1 agents."
+        );
+
+    std::vector< unsigned char > buffer;
+    auto put = [&buffer](uint64_t x, size_t nbytes) -> void {
+        for (size_t b = 0u; b < nbytes; ++b)
+            buffer.push_back(static_cast< unsigned char >(x >> (8u * b)));
+    };
+
+    size_t nties = 0u, nmemberships = 0u;
+    for (const auto & a : population)
+    {
+        nties += a.n_neighbors;
+        nmemberships += a.n_entities;
+    }
+
+    buffer.reserve(
+        44u + 8u * (n + 1u) + 8u * nties + 8u * nmemberships
+    );
+
+    // Header
+    const char magic[] = "EPIWNETS";
+    buffer.insert(buffer.end(), magic, magic + 8);
+    put(EPI_SNAPSHOT_VERSION, 4u);
+    put(n, 8u);
+    put(directed ? 1u : 0u, 1u);
+    put(nties, 8u);
+    put(nmemberships, 8u);
+
+    // Offsets, targets, and locations (CSR)
+    size_t offset = 0u;
+    put(0u, 8u);
+    for (const auto & a : population)
+    {
+        offset += a.n_neighbors;
+        put(offset, 8u);
+    }
+
+    for (const auto & a : population)
+    {
+        const size_t * ids = a.neighbors_data();
+        for (size_t k = 0u; k < a.n_neighbors; ++k)
+            put(ids[k], 4u);
+    }
+
+    for (size_t i = 0u; i < n; ++i)
+    {
+
+        const auto & a = population[i];
+        const size_t * locs = network_csr ?
+            (network_locations->data() + (*network_offsets)[i]) :
+            (a.neighbors_locations != nullptr ?
+                a.neighbors_locations->data() : nullptr);
+
+        for (size_t k = 0u; k < a.n_neighbors; ++k)
+            put(locs[k], 4u);
+
+    }
+
+    // Entity memberships
+    for (const auto & a : population)
+        for (size_t e = 0u; e < a.n_entities; ++e)
+            put(static_cast< uint64_t >(a.id), 4u);
+
+    for (const auto & a : population)
+        for (size_t e = 0u; e < a.n_entities; ++e)
+            put(a.entities[e], 4u);
+
+    std::ofstream file(fn, std::ios_base::out | std::ios_base::binary);
+
+    if (!file)
+        throw std::runtime_error(
+            "Could not open file \"" + fn + "\" for writing."
+        );
+
+    file.write(
+        reinterpret_cast< const char * >(buffer.data()),
+        static_cast< std::streamsize >(buffer.size())
+    );
+
+    if (!file)
+        throw std::runtime_error("Error while writing to \"" + fn + "\".");
+
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::agents_from_network_snapshot(std::string fn)
+{
+
+    std::vector< unsigned char > buffer =
+        read_file_bytes< unsigned char >(fn);
+
+    ByteReader reader(buffer, fn);
+
+    if (!reader.check_magic("EPIWNETS"))
+        throw std::runtime_error(
+            "The file \"" + fn + "\" is not an epiworld network snapshot."
+        );
+
+    reader.need(29u);
+    uint64_t version = reader.get(4u);
+    if (version != EPI_SNAPSHOT_VERSION)
+        throw std::runtime_error(
+            "The network snapshot \"" + fn + "\" has version " +
+            std::to_string(version) + ", expected " +
+            std::to_string(EPI_SNAPSHOT_VERSION) + "."
+        );
+
+    size_t n            = static_cast< size_t >(reader.get(8u));
+    bool directed_      = reader.get(1u) != 0u;
+    size_t nties        = static_cast< size_t >(reader.get(8u));
+    size_t nmemberships = static_cast< size_t >(reader.get(8u));
+
+    if (n > static_cast< size_t >(std::numeric_limits< uint32_t >::max()))
+        reader.error();
+
+    // Validating against the current model
+    if ((population.size() != 0u) && (population.size() != n))
+        throw std::length_error(
+            "The network snapshot has " + std::to_string(n) +
+            " agents, while the model has " +
+            std::to_string(population.size()) + "."
+        );
+
+    if ((population.size() != 0u) && (directed_ != directed))
+        throw std::logic_error(
+            std::string("The network snapshot is ") +
+            (directed_ ? "directed" : "undirected") +
+            ", while the model is not."
+        );
+
+    // Each of these takes at least 8 bytes per element, so they are bounded
+    // before computing the size (which could overflow otherwise)
+    size_t nleft = reader.remaining() / 8u;
+    if ((n >= nleft) || (nties > nleft) || (nmemberships > nleft))
+        reader.error();
+
+    reader.need(8u * (n + 1u) + 8u * nties + 8u * nmemberships);
+
+    std::vector< size_t > offsets(n + 1u);
+    for (auto & o : offsets)
+        o = static_cast< size_t >(reader.get(8u));
+
+    if ((offsets.front() != 0u) || (offsets.back() != nties))
+        reader.error();
+
+    for (size_t i = 0u; i < n; ++i)
+        if (offsets[i + 1u] < offsets[i])
+            reader.error();
+
+    std::vector< size_t > targets(nties), locations(nties);
+    for (auto & t : targets)
+    {
+        t = static_cast< size_t >(reader.get(4u));
+        if (t >= n)
+            reader.error();
+    }
+
+    // Locations index the target's neighbors
+    for (size_t k = 0u; k < nties; ++k)
+    {
+        locations[k] = static_cast< size_t >(reader.get(4u));
+        size_t t = targets[k];
+        if (locations[k] >= (offsets[t + 1u] - offsets[t]))
+            reader.error();
+    }
+
+    std::vector< int > agents_ids(nmemberships), entities_ids(nmemberships);
+    for (auto & a : agents_ids)
+        a = static_cast< int >(reader.get(4u));
+
+    for (auto & e : entities_ids)
+        e = static_cast< int >(reader.get(4u));
+
+    // Creating the agents (this also resets the CSR arrays)
+    agents_empty_graph(static_cast< epiworld_fast_uint >(n));
+    directed = directed_;
+
+    if (network_csr)
+    {
+
+        for (size_t i = 0u; i < n; ++i)
+            population[i].n_neighbors = offsets[i + 1u] - offsets[i];
+
+        *network_offsets   = std::move(offsets);
+        *network_targets   = std::move(targets);
+        *network_locations = std::move(locations);
+
+    }
+    else
+    {
+
+        for (size_t i = 0u; i < n; ++i)
+        {
+
+            auto & a = population[i];
+            a.n_neighbors = offsets[i + 1u] - offsets[i];
+
+            if (a.n_neighbors == 0u)
+                continue;
+
+            a.neighbors = new std::vector< size_t >(
+                targets.begin() + offsets[i],
+                targets.begin() + offsets[i + 1u]
+            );
+
+            a.neighbors_locations = new std::vector< size_t >(
+                locations.begin() + offsets[i],
+                locations.begin() + offsets[i + 1u]
+            );
+
+        }
+
+    }
+
+    if (nmemberships > 0u)
+        load_agents_entities_ties(agents_ids, entities_ids);
+
+}
+
+#undef EPI_SNAPSHOT_VERSION
+
 template<typename TSeq>
 inline void Model<TSeq>::set_rand_gamma(epiworld_double alpha, epiworld_double beta)
 {
@@ -792,11 +1564,27 @@ template<typename TSeq>
 inline void Model<TSeq>::set_backup()
 {
 
-    if (population_backup.size() == 0u)
-        population_backup = std::vector< Agent<TSeq> >(population);
+    if ((population_backup == nullptr) || (population_backup->size() == 0u))
+    {
+        population_backup = std::make_shared< const std::vector< Agent<TSeq> > >(
+            population
+        );
+
+        network_modified = false;
+    }
 
-    if (entities_backup.size() == 0u)
-        entities_backup = std::vector< Entity<TSeq> >(entities);
+    if ((entities_backup == nullptr) || (entities_backup->size() == 0u))
+        entities_backup = std::make_shared< const std::vector< Entity<TSeq> > >(
+            entities
+        );
+
+    // Rewiring modifies the CSR arrays, so these are restored too (the
+    // arrays are shared until the first rewire)
+    if (network_csr && (network_targets_backup == nullptr))
+    {
+        network_targets_backup   = network_targets;
+        network_locations_backup = network_locations;
+    }
 
 }
 
@@ -806,131 +1594,166 @@ inline std::shared_ptr< std::mt19937 > & Model<TSeq>::get_rand_endgine()
     return engine;
 }
 
+template<typename TSeq>
+template<typename TDist>
+inline typename TDist::result_type Model<TSeq>::rdraw(TDist & dist)
+{
+
+    // Distributions may hold state, so threads use their own copy
+    if (update_parallel_active)
+    {
+        TDist dist_thread(dist.param());
+
+        if (rng_counter)
+            return dist_thread(engine_counter_threads[EPI_GET_THREAD_ID()]);
+
+        return dist_thread(engine_threads[EPI_GET_THREAD_ID()]);
+    }
+
+    // The same goes for counter-based streams: a draw must not depend on
+    // values cached from another stream.
+    if (rng_counter)
+    {
+        TDist dist_stream(dist.param());
+        return dist_stream(engine_counter);
+    }
+
+    return dist(*engine);
+
+}
+
+template<typename TSeq>
+template<typename TDist>
+inline typename TDist::result_type Model<TSeq>::rdraw(
+    TDist & dist,
+    const typename TDist::param_type & par
+)
+{
+
+    if (update_parallel_active)
+    {
+        TDist dist_thread(par);
+
+        if (rng_counter)
+            return dist_thread(engine_counter_threads[EPI_GET_THREAD_ID()]);
+
+        return dist_thread(engine_threads[EPI_GET_THREAD_ID()]);
+    }
+
+    if (rng_counter)
+    {
+        TDist dist_stream(par);
+        return dist_stream(engine_counter);
+    }
+
+    auto old_param = dist.param();
+    dist.param(par);
+    auto ans = dist(*engine);
+    dist.param(old_param);
+
+    return ans;
+
+}
+
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::runif() {
     // CHECK_INIT()
-    return runifd(*engine);
+    return rdraw(runifd);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::runif(epiworld_double a, epiworld_double b) {
     // CHECK_INIT()
-    return runifd(*engine) * (b - a) + a;
+    return rdraw(runifd) * (b - a) + a;
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rnorm() {
     // CHECK_INIT()
-    return rnormd(*engine);
+    return rdraw(rnormd);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rnorm(epiworld_double mean, epiworld_double sd) {
     // CHECK_INIT()
-    return rnormd(*engine) * sd + mean;
+    return rdraw(rnormd) * sd + mean;
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rgamma() {
-    return rgammad(*engine);
+    return rdraw(rgammad);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rgamma(epiworld_double alpha, epiworld_double beta) {
-    auto old_param = rgammad.param();
-    rgammad.param(std::gamma_distribution<>::param_type(alpha, beta));
-    epiworld_double ans = rgammad(*engine);
-    rgammad.param(old_param);
-    return ans;
+    return rdraw(rgammad, std::gamma_distribution<>::param_type(alpha, beta));
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rexp() {
-    return rexpd(*engine);
+    return rdraw(rexpd);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rexp(epiworld_double lambda) {
-    auto old_param = rexpd.param();
-    rexpd.param(std::exponential_distribution<>::param_type(lambda));
-    epiworld_double ans = rexpd(*engine);
-    rexpd.param(old_param);
-    return ans;
+    return rdraw(rexpd, std::exponential_distribution<>::param_type(lambda));
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rlognormal() {
-    return rlognormald(*engine);
+    return rdraw(rlognormald);
 }
 
 template<typename TSeq>
 inline epiworld_double Model<TSeq>::rlognormal(epiworld_double mean, epiworld_double shape) {
-    auto old_param = rlognormald.param();
-    rlognormald.param(std::lognormal_distribution<>::param_type(mean, shape));
-    epiworld_double ans = rlognormald(*engine);
-    rlognormald.param(old_param);
-    return ans;
+    return rdraw(rlognormald, std::lognormal_distribution<>::param_type(mean, shape));
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rbinom() {
-    return rbinomd(*engine);
+    return rdraw(rbinomd);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rbinom(int n, epiworld_double p) {
-    auto old_param = rbinomd.param();
-    rbinomd.param(std::binomial_distribution<>::param_type(n, p));
-    epiworld_double ans = rbinomd(*engine);
-    rbinomd.param(old_param);
-    return ans;
+    return rdraw(rbinomd, std::binomial_distribution<>::param_type(n, p));
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rnbinom() {
-    return rnbinomd(*engine);
+    return rdraw(rnbinomd);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rnbinom(int n, epiworld_double p) {
-    auto old_param = rnbinomd.param();
-    rnbinomd.param(std::negative_binomial_distribution<>::param_type(n, p));
-    int ans = rnbinomd(*engine);
-    rnbinomd.param(old_param);
-    return ans;
+    return rdraw(rnbinomd, std::negative_binomial_distribution<>::param_type(n, p));
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rgeom() {
-    return rgeomd(*engine);
+    return rdraw(rgeomd);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rgeom(epiworld_double p) {
-    auto old_param = rgeomd.param();
-    rgeomd.param(std::geometric_distribution<>::param_type(p));
-    int ans = rgeomd(*engine);
-    rgeomd.param(old_param);
-    return ans;
+    return rdraw(rgeomd, std::geometric_distribution<>::param_type(p));
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rpoiss() {
-    return rpoissd(*engine);
+    return rdraw(rpoissd);
 }
 
 template<typename TSeq>
 inline int Model<TSeq>::rpoiss(epiworld_double lambda) {
-    auto old_param = rpoissd.param();
-    rpoissd.param(std::poisson_distribution<>::param_type(lambda));
-    int ans = rpoissd(*engine);
-    rpoissd.param(old_param);
-    return ans;
+    return rdraw(rpoissd, std::poisson_distribution<>::param_type(lambda));
 }
 
 template<typename TSeq>
 inline void Model<TSeq>::seed(size_t s) {
     this->engine->seed(s);
+    this->rng_counter_seed = static_cast< uint64_t >(s);
+    this->engine_counter.seed(rng_counter_seed);
 }
 
 template<typename TSeq>
@@ -1227,6 +2050,13 @@ inline void Model<TSeq>::agents_from_edgelist(
     bool directed
 ) {
 
+    // The CSR arrays are built directly from the edgelist
+    if (network_csr)
+    {
+        network_csr_build(source, target, size);
+        return;
+    }
+
     AdjList al(source, target, size, directed);
     agents_from_adjlist(al);
 
@@ -1235,22 +2065,49 @@ inline void Model<TSeq>::agents_from_edgelist(
 template<typename TSeq>
 inline void Model<TSeq>::agents_from_adjlist(AdjList al) {
 
+    // Reading the ties straight from the CSR arrays
+    al.flatten();
+    const auto & offsets = al.get_offsets();
+    const auto & ids     = al.get_ids();
+    size_t n = al.vcount();
+
+    if (network_csr)
+    {
+
+        std::vector< int > source;
+        std::vector< int > target;
+        source.reserve(ids.size());
+        target.reserve(ids.size());
+
+        for (size_t i = 0u; i < n; ++i)
+        {
+            for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
+            {
+                source.push_back(static_cast< int >(i));
+                target.push_back(ids[k]);
+            }
+        }
+
+        network_csr_build(source, target, static_cast< int >(n));
+
+        return;
+
+    }
+
     // Resizing the people
-    agents_empty_graph(al.vcount());
-    
-    const auto & tmpdat = al.get_dat();
+    agents_empty_graph(n);
     
-    for (size_t i = 0u; i < tmpdat.size(); ++i)
+    for (size_t i = 0u; i < n; ++i)
     {
 
         // population[i].id    = i;
         population[i].model = this;
 
-        for (const auto & link: tmpdat[i])
+        for (size_t k = offsets[i]; k < offsets[i + 1]; ++k)
         {
 
             population[i].add_neighbor(
-                population[link.first],
+                population[ids[k]],
                 true, true
                 );
 
@@ -1320,7 +2177,13 @@ inline Model<TSeq> & Model<TSeq>::run(
     this->ndays = ndays;
 
     if (seed >= 0)
-        engine->seed(seed);
+        this->seed(static_cast< size_t >(seed));
+    else if (rng_counter)
+    {
+        // New key for the counter-based streams
+        rng_counter_seed = static_cast< uint64_t >((*engine)());
+        engine_counter.seed(rng_counter_seed);
+    }
 
     array_double_tmp.resize(std::max(
         size(),
@@ -1405,6 +2268,10 @@ inline Model<TSeq> & Model<TSeq>::run(
     // The last reaches the end...
     this->current_date--;
 
+    // Spilling the last chunk of transmissions
+    if (db.is_transmission_stream_on())
+        db.transmission_stream_flush();
+
     chrono_end();
 
     return *this;
@@ -1496,8 +2363,13 @@ inline void Model<TSeq>::run_multiple(
     if (sums < nexperiments)
         nreplicates[nthreads - 1] += (nexperiments - sums);
 
+    // With dynamic scheduling, threads pull the next replicate from
+    // `sim_next`, and the first thread reports the progress of all.
+    size_t sim_next = 0u;
+    size_t sim_done = 0u;
+
     Progress pb_multiple(
-        nreplicates[0u],
+        run_multiple_dynamic ? nexperiments : nreplicates[0u],
         EPIWORLD_PROGRESS_BAR_WIDTH
         );
 
@@ -1529,44 +2401,105 @@ inline void Model<TSeq>::run_multiple(
     }
     #endif
     
-    #pragma omp parallel shared(these, nreplicates, nreplicates_csum, seeds_n) \
+    #pragma omp parallel shared(these, nreplicates, nreplicates_csum, seeds_n, \
+        sim_next, sim_done) \
         firstprivate(nexperiments, nthreads, fun, reset, verbose, pb_multiple, ndays) \
         default(shared)
     {
 
         auto iam = omp_get_thread_num();
 
-        for (size_t n = 0u; n < nreplicates[iam]; ++n)
+        if (run_multiple_dynamic)
         {
-            size_t sim_id = nreplicates_csum[iam] + n;
-            if (iam == 0)
+
+            Model<TSeq> * m = (iam == 0) ? this : these[iam - 1];
+
+            size_t n = 0u;        // Replicates run by this thread
+            size_t n_shown = 0u;  // Replicates shown in the progress bar
+            while (true)
             {
 
-                // Checking if the user interrupted the simulation
-                EPI_CHECK_USER_INTERRUPT(n);
+                size_t sim_id;
+                #pragma omp atomic capture
+                sim_id = sim_next++;
+
+                if (sim_id >= nexperiments)
+                    break;
 
-                // Initializing the seed
-                run(ndays, seeds_n[sim_id]);
+                if (iam == 0)
+                {
+                    // Checking if the user interrupted the simulation
+                    EPI_CHECK_USER_INTERRUPT(n);
+                }
+
+                // The seed depends on the replicate, not on the thread
+                m->run(ndays, seeds_n[sim_id]);
 
                 if (fun)
-                    fun(n, this);
+                    fun(sim_id, m);
+
+                ++n;
+
+                #pragma omp atomic update
+                sim_done++;
 
                 // Only the first one prints
-                if (verbose)
-                    pb_multiple.next();                
+                if ((iam == 0) && verbose)
+                {
 
-            } else {
+                    size_t sim_done_now;
+                    #pragma omp atomic read
+                    sim_done_now = sim_done;
 
-                // Initializing the seed
-                these[iam - 1]->run(ndays, seeds_n[sim_id]);
+                    while (n_shown < sim_done_now)
+                    {
+                        pb_multiple.next();
+                        ++n_shown;
+                    }
 
-                if (fun)
-                    fun(sim_id, these[iam - 1]);
+                }
 
             }
 
+            nreplicates[iam] = n;
+
+        }
+        else
+        {
+
+            for (size_t n = 0u; n < nreplicates[iam]; ++n)
+            {
+                size_t sim_id = nreplicates_csum[iam] + n;
+                if (iam == 0)
+                {
+
+                    // Checking if the user interrupted the simulation
+                    EPI_CHECK_USER_INTERRUPT(n);
+
+                    // Initializing the seed
+                    run(ndays, seeds_n[sim_id]);
+
+                    if (fun)
+                        fun(n, this);
+
+                    // Only the first one prints
+                    if (verbose)
+                        pb_multiple.next();                
+
+                } else {
+
+                    // Initializing the seed
+                    these[iam - 1]->run(ndays, seeds_n[sim_id]);
+
+                    if (fun)
+                        fun(sim_id, these[iam - 1]);
+
+                }
+
             
 
+            }
+
         }
         
     }
@@ -1631,31 +2564,184 @@ inline void Model<TSeq>::run_multiple(
 template<typename TSeq>
 inline void Model<TSeq>::update_state() {
 
+    #if defined(_OPENMP) || defined(__OPENMP)
+    if (update_nthreads > 1)
+    {
+        update_state_parallel();
+
+        if (rng_counter)
+            rng_counter_stream(0u, RNG_PHASE_MODEL);
+
+        events_run();
+        return;
+    }
+    #endif
+
     // Next state
     if (use_queuing)
     {
-        int i = -1;
-        for (auto & p: population)
-            if (queue[++i] > 0)
+
+        // Only the agents in the queue (in id order)
+        for (auto i : queue.get_active_agents())
+        {
+
+            auto & p = population[i];
+
+            if (state_fun[p.state])
             {
-                if (state_fun[p.state])
-                    state_fun[p.state](&p, this);
+                if (rng_counter)
+                    rng_counter_stream(p.id, RNG_PHASE_UPDATE);
+
+                state_fun[p.state](&p, this);
             }
 
+        }
+
     }
     else
     {
 
         for (auto & p: population)
             if (state_fun[p.state])
-                    state_fun[p.state](&p, this);
+            {
+                if (rng_counter)
+                    rng_counter_stream(p.id, RNG_PHASE_UPDATE);
+
+                state_fun[p.state](&p, this);
+            }
 
     }
 
+    if (rng_counter)
+        rng_counter_stream(0u, RNG_PHASE_MODEL);
+
     events_run();
     
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::update_state_parallel() {
+
+    #if defined(_OPENMP) || defined(__OPENMP)
+
+    size_t nthreads = static_cast< size_t >(update_nthreads);
+
+    // Preparing the threads' buffers
+    if (events_threads.size() != nthreads)
+    {
+        events_threads.resize(nthreads);
+        nactions_threads.resize(nthreads, 0u);
+        events_calls_threads.resize(nthreads);
+        engine_threads.resize(nthreads);
+        engine_counter_threads.resize(nthreads);
+        array_double_tmp_threads.resize(nthreads);
+        array_virus_tmp_threads.resize(nthreads);
+    }
+
+    for (size_t t = 0u; t < nthreads; ++t)
+    {
+
+        // One stream per thread, seeded from the model's engine. With
+        // counter-based streams, threads only share the key.
+        if (rng_counter)
+            engine_counter_threads[t].seed(rng_counter_seed);
+        else
+            engine_threads[t].seed((*engine)());
+
+        if (array_double_tmp_threads[t].size() != array_double_tmp.size())
+            array_double_tmp_threads[t].resize(array_double_tmp.size());
+
+        if (array_virus_tmp_threads[t].size() != array_virus_tmp.size())
+            array_virus_tmp_threads[t].resize(array_virus_tmp.size());
+
+    }
+
+    // Exceptions cannot leave the parallel region
+    std::vector< std::exception_ptr > errors(nthreads, nullptr);
+
+    // With queuing, only the agents in the queue are visited
+    const size_t * ids = nullptr;
+    int n = static_cast< int >(population.size());
+    if (use_queuing)
+    {
+        const auto & active_ids = queue.get_active_agents();
+        ids = active_ids.data();
+        n   = static_cast< int >(active_ids.size());
+    }
+
+    update_parallel_active = true;
+
+    // The static schedule assigns contiguous blocks of agents to the
+    // threads in order, so appending the buffers thread by thread
+    // preserves the agent id order.
+    #pragma omp parallel for num_threads(update_nthreads) schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+
+        auto & p = population[ids != nullptr ? ids[i] : i];
+
+        if (!state_fun[p.state])
+            continue;
+
+        if (rng_counter)
+            rng_counter_stream(p.id, RNG_PHASE_UPDATE);
+
+        try
+        {
+            state_fun[p.state](&p, this);
+        }
+        catch (...)
+        {
+            if (!errors[EPI_GET_THREAD_ID()])
+                errors[EPI_GET_THREAD_ID()] = std::current_exception();
+        }
+
+    }
+
+    update_parallel_active = false;
+
+    // Merging the buffers (custom functions are appended to the model's,
+    // so their indices are shifted)
+    for (size_t t = 0u; t < nthreads; ++t)
+    {
+
+        int call_offset = static_cast< int >(events_calls.size());
+
+        for (size_t k = 0u; k < nactions_threads[t]; ++k)
+        {
+
+            if (++nactions > events.size())
+                events.push_back(std::move(events_threads[t][k]));
+            else
+                events[nactions - 1u] = std::move(events_threads[t][k]);
+
+            if (events[nactions - 1u].idx_call >= 0)
+                events[nactions - 1u].idx_call += call_offset;
+
+        }
+
+        for (auto & call : events_calls_threads[t])
+            events_calls.push_back(std::move(call));
+
+        nactions_threads[t] = 0u;
+        events_calls_threads[t].clear();
+
+    }
+
+    for (auto & e : errors)
+        if (e)
+        {
+            nactions = 0u;
+            events_calls.clear();
+            std::rethrow_exception(e);
+        }
+
+    #endif
+
+    return;
+
+}
+
 template<typename TSeq>
 inline void Model<TSeq>::mutate_virus() {
 
@@ -1671,15 +2757,18 @@ inline void Model<TSeq>::mutate_virus() {
     if (use_queuing)
     {
 
-        int i = -1;
-        for (auto & p: population)
+        for (auto i : queue.get_active_agents())
         {
 
-            if (queue[++i] == 0)
-                continue;
+            auto & p = population[i];
 
             if (p.virus != nullptr)
+            {
+                if (rng_counter)
+                    rng_counter_stream(p.id, RNG_PHASE_MUTATION);
+
                 p.virus->mutate(this);
+            }
 
         }
 
@@ -1691,11 +2780,19 @@ inline void Model<TSeq>::mutate_virus() {
         {
 
             if (p.virus != nullptr)
+            {
+                if (rng_counter)
+                    rng_counter_stream(p.id, RNG_PHASE_MUTATION);
+
                 p.virus->mutate(this);
+            }
 
         }
 
     }
+
+    if (rng_counter)
+        rng_counter_stream(1u, RNG_PHASE_MODEL);
     
 
 }
@@ -1772,7 +2869,10 @@ template<typename TSeq>
 inline void Model<TSeq>::rewire() {
 
     if (rewire_fun)
+    {
+        network_modified = true;
         rewire_fun(&population, this, rewire_prop);
+    }
 }
 
 
@@ -1799,6 +2899,26 @@ inline void Model<TSeq>::write_data(
 
 }
 
+template<typename TSeq>
+inline void Model<TSeq>::write_data_binary(
+    std::string fn_virus_hist,
+    std::string fn_tool_hist,
+    std::string fn_total_hist,
+    std::string fn_transmission,
+    std::string fn_transition,
+    std::string fn_reproductive_number,
+    std::string fn_generation_time
+    ) const
+{
+
+    db.write_data_binary(
+        fn_virus_hist, fn_tool_hist,
+        fn_total_hist, fn_transmission, fn_transition,
+        fn_reproductive_number, fn_generation_time
+        );
+
+}
+
 template<typename TSeq>
 inline void Model<TSeq>::write_edgelist(
     std::string fn
@@ -1818,11 +2938,9 @@ inline void Model<TSeq>::write_edgelist(
         for (const auto & p : wseq)
         {
 
-            if (p->neighbors == nullptr)
-                continue;
-
-            for (auto & n : *p->neighbors)
-                efile << p->id << " " << n << "\n";
+            const size_t * neigh_ids = p->neighbors_data();
+            for (size_t i = 0u; i < p->n_neighbors; ++i)
+                efile << p->id << " " << neigh_ids[i] << "\n";
         }
 
     } else {
@@ -1830,12 +2948,10 @@ inline void Model<TSeq>::write_edgelist(
         for (const auto & p : wseq)
         {
 
-            if (p->neighbors == nullptr)
-                continue;
-
-            for (auto & n : *p->neighbors)
-                if (static_cast<int>(p->id) <= static_cast<int>(n))
-                    efile << p->id << " " << n << "\n";
+            const size_t * neigh_ids = p->neighbors_data();
+            for (size_t i = 0u; i < p->n_neighbors; ++i)
+                if (static_cast<int>(p->id) <= static_cast<int>(neigh_ids[i]))
+                    efile << p->id << " " << neigh_ids[i] << "\n";
         }
 
     }
@@ -1858,13 +2974,12 @@ std::vector< int > & target
 
         for (const auto & p : wseq)
         {
-            if (p->neighbors == nullptr)
-                continue;
 
-            for (auto & n : *p->neighbors)
+            const size_t * neigh_ids = p->neighbors_data();
+            for (size_t i = 0u; i < p->n_neighbors; ++i)
             {
                 source.push_back(static_cast<int>(p->id));
-                target.push_back(static_cast<int>(n));
+                target.push_back(static_cast<int>(neigh_ids[i]));
             }
         }
 
@@ -1873,13 +2988,11 @@ std::vector< int > & target
         for (const auto & p : wseq)
         {
 
-            if (p->neighbors == nullptr)
-                continue;
-
-            for (auto & n : *p->neighbors) {
-                if (static_cast<int>(p->id) <= static_cast<int>(n)) {
+            const size_t * neigh_ids = p->neighbors_data();
+            for (size_t i = 0u; i < p->n_neighbors; ++i) {
+                if (static_cast<int>(p->id) <= static_cast<int>(neigh_ids[i])) {
                     source.push_back(static_cast<int>(p->id));
-                    target.push_back(static_cast<int>(n));
+                    target.push_back(static_cast<int>(neigh_ids[i]));
                 }
             }
         }
@@ -1901,9 +3014,15 @@ inline void Model<TSeq>::reset() {
     // Restablishing people
     pb = Progress(ndays, 80);
 
-    if (population_backup.size())
+    // In-place resets only need the backup if the network changed (CSR
+    // networks are restored below)
+    bool restore_population = !reset_inplace ||
+        (network_modified && !network_csr);
+
+    if (restore_population && (population_backup != nullptr) &&
+        population_backup->size())
     {
-        population = population_backup;
+        population = *population_backup;
     
         // Ensuring the population is poiting to the model
         for (auto & p : population)
@@ -1913,7 +3032,7 @@ inline void Model<TSeq>::reset() {
         for (size_t i = 0; i < population.size(); ++i)
         {
 
-            if (population[i] != (population_backup)[i])
+            if (population[i] != (*population_backup)[i])
                 throw std::logic_error("Model::reset population doesn't match.");
 
         }
@@ -1921,9 +3040,20 @@ inline void Model<TSeq>::reset() {
 
     }
 
+    if (network_targets_backup != nullptr)
+    {
+        network_targets   = network_targets_backup;
+        network_locations = network_locations_backup;
+    }
+
+    network_modified = false;
+
     for (auto & p : population)
         p.reset();
 
+    // Instances from previous runs are released
+    viruses_pool.clear();
+
     #ifdef EPI_DEBUG
     for (auto & a: population)
     {
@@ -1933,15 +3063,16 @@ inline void Model<TSeq>::reset() {
     }
     #endif
         
-    if (entities_backup.size())
+    if (!reset_inplace && (entities_backup != nullptr) &&
+        entities_backup->size())
     {
-        entities = entities_backup;
+        entities = *entities_backup;
 
         #ifdef EPI_DEBUG
         for (size_t i = 0; i < entities.size(); ++i)
         {
 
-            if (entities[i] != (entities_backup)[i])
+            if (entities[i] != (*entities_backup)[i])
                 throw std::logic_error("Model::reset entities don't match.");
 
         }
@@ -1951,9 +3082,15 @@ inline void Model<TSeq>::reset() {
 
     for (auto & e: entities)
         e.reset();
+
+    if (tool_effects_cache)
+        tool_effects_cache_invalidate();
     
     current_date = 0;
 
+    if (rng_counter)
+        rng_counter_stream(0u, RNG_PHASE_RESET);
+
     db.reset();
 
     // This also clears the queue
@@ -2071,6 +3208,9 @@ inline Model<TSeq> & Model<TSeq>::read_params(std::string fn, bool overwrite)
     for (auto & p : params_map)
         add_param(p.second, p.first, overwrite);
 
+    if (tool_effects_cache)
+        tool_effects_cache_invalidate();
+
     return *this;
 
 }
@@ -2092,6 +3232,9 @@ inline void Model<TSeq>::set_param(std::string pname, epiworld_double value)
 
     parameters[pname] = value;
 
+    if (tool_effects_cache)
+        tool_effects_cache_invalidate();
+
     return;
 
 }
@@ -2340,6 +3483,116 @@ inline bool Model<TSeq>::is_queuing_on() const
     return use_queuing;
 }
 
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::run_multiple_dynamic_on()
+{
+    run_multiple_dynamic = true;
+    return *this;
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::run_multiple_dynamic_off()
+{
+    run_multiple_dynamic = false;
+    return *this;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_run_multiple_dynamic_on() const
+{
+    return run_multiple_dynamic;
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::update_parallel_on(int nthreads)
+{
+
+    if (nthreads < 1)
+        throw std::range_error(
+            "The number of threads must be at least 1. Got " +
+            std::to_string(nthreads) + "."
+        );
+
+    update_nthreads = nthreads;
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::update_parallel_off()
+{
+    update_nthreads = 1;
+    return *this;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_update_parallel_on() const
+{
+    return update_nthreads > 1;
+}
+
+template<typename TSeq>
+inline void Model<TSeq>::rng_counter_stream(size_t agent_id, uint32_t phase)
+{
+
+    Philox4x32 & eng = update_parallel_active ?
+        engine_counter_threads[EPI_GET_THREAD_ID()] : engine_counter;
+
+    eng.set_stream(
+        static_cast< uint32_t >(agent_id),
+        static_cast< uint32_t >(current_date),
+        phase
+    );
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::rng_counter_on()
+{
+
+    rng_counter = true;
+    engine_counter.seed(rng_counter_seed);
+
+    return *this;
+
+}
+
+template<typename TSeq>
+inline Model<TSeq> & Model<TSeq>::rng_counter_off()
+{
+    rng_counter = false;
+    return *this;
+}
+
+template<typename TSeq>
+inline bool Model<TSeq>::is_rng_counter_on() const
+{
+    return rng_counter;
+}
+
+template<typename TSeq>
+inline std::vector< epiworld_double > & Model<TSeq>::get_array_double_tmp()
+{
+
+    if (update_parallel_active)
+        return array_double_tmp_threads[EPI_GET_THREAD_ID()];
+
+    return array_double_tmp;
+
+}
+
+template<typename TSeq>
+inline std::vector< Virus<TSeq> * > & Model<TSeq>::get_array_virus_tmp()
+{
+
+    if (update_parallel_active)
+        return array_virus_tmp_threads[EPI_GET_THREAD_ID()];
+
+    return array_virus_tmp;
+
+}
+
 template<typename TSeq>
 inline Queue<TSeq> & Model<TSeq>::get_queue()
 {
@@ -2431,22 +3684,26 @@ inline bool Model<TSeq>::operator==(const Model<TSeq> & other) const
         "Model:: using_backup don't match"
         )
     
-    if ((population_backup.size() != 0) & (other.population_backup.size() != 0))
+    size_t n_backup = population_backup ? population_backup->size() : 0u;
+    size_t n_backup_other = other.population_backup ?
+        other.population_backup->size() : 0u;
+
+    if ((n_backup != 0) & (n_backup_other != 0))
     {
 
         // False is population_backup.size() != other.population_backup.size()
-        if (population_backup.size() != other.population_backup.size())
+        if (n_backup != n_backup_other)
             return false;
 
-        for (size_t i = 0u; i < population_backup.size(); ++i)
+        for (size_t i = 0u; i < n_backup; ++i)
         {
-            if (population_backup[i] != other.population_backup[i])
+            if ((*population_backup)[i] != (*other.population_backup)[i])
                 return false;
         }
         
-    } else if ((population_backup.size() == 0) & (other.population_backup.size() != 0)) {
+    } else if ((n_backup == 0) & (n_backup_other != 0)) {
         return false;
-    } else if ((population_backup.size() != 0) & (other.population_backup.size() == 0))
+    } else if ((n_backup != 0) & (n_backup_other == 0))
     {
         return false;
     }
@@ -2465,6 +3722,14 @@ inline bool Model<TSeq>::operator==(const Model<TSeq> & other) const
         directed != other.directed,
         "Model:: directed don't match"
     )
+
+    EPI_DEBUG_FAIL_AT_TRUE(
+        network_csr != other.network_csr,
+        "Model:: network_csr don't match"
+    )
+
+    VECT_MATCH((*network_offsets), (*other.network_offsets), "Model:: network_offsets don't match")
+    VECT_MATCH((*network_targets), (*other.network_targets), "Model:: network_targets don't match")
     
     // Viruses -----------------------------------------------------------------
     EPI_DEBUG_FAIL_AT_TRUE(
@@ -2502,22 +3767,26 @@ inline bool Model<TSeq>::operator==(const Model<TSeq> & other) const
         "entities don't match"
     )
 
-    if ((entities_backup.size() != 0) & (other.entities_backup.size() != 0))
+    size_t n_ebackup = entities_backup ? entities_backup->size() : 0u;
+    size_t n_ebackup_other = other.entities_backup ?
+        other.entities_backup->size() : 0u;
+
+    if ((n_ebackup != 0) & (n_ebackup_other != 0))
     {
         
-        for (size_t i = 0u; i < entities_backup.size(); ++i)
+        for (size_t i = 0u; i < n_ebackup; ++i)
         {
 
             EPI_DEBUG_FAIL_AT_TRUE(
-                entities_backup[i] != other.entities_backup[i],
+                (*entities_backup)[i] != (*other.entities_backup)[i],
                 "Model:: entities_backup[i] don't match"
             )
 
         }
         
-    } else if ((entities_backup.size() == 0) & (other.entities_backup.size() != 0)) {
+    } else if ((n_ebackup == 0) & (n_ebackup_other != 0)) {
         EPI_DEBUG_FAIL_AT_TRUE(true, "entities_backup don't match")
-    } else if ((entities_backup.size() != 0) & (other.entities_backup.size() == 0))
+    } else if ((n_ebackup != 0) & (n_ebackup_other == 0))
     {
         EPI_DEBUG_FAIL_AT_TRUE(true, "entities_backup don't match")
     }
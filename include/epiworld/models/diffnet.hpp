@@ -85,13 +85,13 @@ inline ModelDiffNet<TSeq>::ModelDiffNet(
 
         // For each one of the possible innovations, we have to compute
         // the adoption probability, which is a function of exposure
-        for (auto & neighbor: agent.get_neighbors())
+        for (auto & neighbor: agent.get_neighbors_view())
         {
 
-            if (neighbor->get_state() == ModelDiffNet<TSeq>::ADOPTER)
+            if (neighbor.get_state() == ModelDiffNet<TSeq>::ADOPTER)
             {
 
-                auto & v = neighbor->get_virus();
+                auto & v = neighbor.get_virus();
                 
                 if (v == nullptr)
                     continue;
@@ -25,9 +25,9 @@
     epiworld_double p_total = m->runif(); \
     for (ans = 0u; ans < n; ++ans) \
     { \
-        if (p_total < m->array_double_tmp[ans]) \
+        if (p_total < m->get_array_double_tmp()[ans]) \
             break; \
-        m->array_double_tmp[ans + 1] += m->array_double_tmp[ans]; \
+        m->get_array_double_tmp()[ans + 1] += m->get_array_double_tmp()[ans]; \
     }
 
 /**
@@ -67,6 +67,16 @@ private:
     static void m_update_hospitalized(Agent<TSeq> * p, Model<TSeq> * m);
     ///@}
 
+    /**
+     * @brief Event for agents detected in the rash state.
+     * 
+     * Moves the agent out of the rash state (removing the virus if the
+     * event has one) and triggers the quarantine. The trigger is set when
+     * the event runs, so `m_update_rash` doesn't modify the model (see
+     * `Model::update_parallel_on()`.)
+     */
+    static void m_detect(Event<TSeq> & a, Model<TSeq> * m);
+
     /**
      * @brief The function that updates the model.
      * 
@@ -392,18 +402,18 @@ LOCAL_UPDATE_FUN(m_update_susceptible) {
         auto & v = neighbor.get_virus();
 
         #ifdef EPI_DEBUG
-        if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+        if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
             throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
         #endif
             
         /* And it is a function of susceptibility_reduction as well */ 
-        m->array_double_tmp[nviruses_tmp] =
+        m->get_array_double_tmp()[nviruses_tmp] =
             (1.0 - p->get_susceptibility_reduction(v, m)) * 
             v->get_prob_infecting(m) * 
             (1.0 - neighbor.get_transmission_reduction(v, m)) 
             ; 
 
-        m->array_virus_tmp[nviruses_tmp++] = &(*v);
+        m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
             
     }
 
@@ -417,7 +427,7 @@ LOCAL_UPDATE_FUN(m_update_susceptible) {
     if (which < 0)
         return;
 
-    p->set_virus(*m->array_virus_tmp[which], m);
+    p->set_virus(*m->get_array_virus_tmp()[which], m);
 
     return; 
 
@@ -471,52 +481,74 @@ LOCAL_UPDATE_FUN(m_update_rash) {
         (m->runif() < 1.0/m->par("Days undetected"))
     )
     {
-        model->system_quarantine_triggered = true;
         detected = true;
 
     }
 
     // Probability of Staying in the rash period vs becoming
     // hospitalized
-    m->array_double_tmp[0] = 1.0/m->par("Rash period");
-    m->array_double_tmp[1] = m->par("Hospitalization rate");
+    m->get_array_double_tmp()[0] = 1.0/m->par("Rash period");
+    m->get_array_double_tmp()[1] = m->par("Hospitalization rate");
 
     // Sampling from the probabilities
     SAMPLE_FROM_PROBS(2, which);
 
+    if (which > 2)
+        throw std::logic_error("The roulette returned an unexpected value.");
+
+    if (detected)
+    {
+        // Recovers, is hospitalized (effectively removed from the
+        // system), or is moved to isolation
+        if (which == 2)
+            model->events_add(
+                p, p->get_virus(), nullptr, nullptr,
+                ModelMeaslesQuarantine::ISOLATED_RECOVERED,
+                Queue<TSeq>::Everyone, m_detect, -1, -1
+            );
+        else
+            model->events_add(
+                p, nullptr, nullptr, nullptr,
+                which == 1 ?
+                    ModelMeaslesQuarantine::DETECTED_HOSPITALIZED :
+                    ModelMeaslesQuarantine::ISOLATED,
+                Queue<TSeq>::NoOne, m_detect, -1, -1
+            );
+
+    }
     // Recovers
-    if (which == 2)
+    else if (which == 2)
     {
-        p->rm_agent_by_virus(
-            m,
-            detected ?
-                ModelMeaslesQuarantine::ISOLATED_RECOVERED:
-                ModelMeaslesQuarantine::RECOVERED
-        );
+        p->rm_agent_by_virus(m, ModelMeaslesQuarantine::RECOVERED);
     }
     else if (which == 1)
     {
         // If hospitalized, then the agent is removed from the system
         // effectively
-        p->change_state(
-            m,
-            detected ?
-                ModelMeaslesQuarantine::DETECTED_HOSPITALIZED :
-                ModelMeaslesQuarantine::HOSPITALIZED
-            );
-    }
-    else if (which != 0)
-    {
-        throw std::logic_error("The roulette returned an unexpected value.");
-    } else if ((which == 0u) && detected)
-    {
-        // If the agent is not hospitalized, then it is moved to
-        // isolation.
-        p->change_state(m, ModelMeaslesQuarantine::ISOLATED);
+        p->change_state(m, ModelMeaslesQuarantine::HOSPITALIZED);
     }
     
 };
 
+template<typename TSeq>
+inline void ModelMeaslesQuarantine<TSeq>::m_detect(
+    Event<TSeq> & a,
+    Model<TSeq> * m
+) {
+
+    GET_MODEL(m, model);
+
+    if (a.virus != nullptr)
+        default_rm_virus<TSeq>(a, m);
+    else
+        default_change_state<TSeq>(a, m);
+
+    model->system_quarantine_triggered = true;
+
+    return;
+
+}
+
 LOCAL_UPDATE_FUN(m_update_isolated) {
 
     GET_MODEL(m, model);
@@ -531,8 +563,8 @@ LOCAL_UPDATE_FUN(m_update_isolated) {
 
     // Probability of staying in the rash period vs becoming
     // hospitalized
-    m->array_double_tmp[0] = 1.0/m->par("Rash period");
-    m->array_double_tmp[1] = m->par("Hospitalization rate");
+    m->get_array_double_tmp()[0] = 1.0/m->par("Rash period");
+    m->get_array_double_tmp()[1] = m->par("Hospitalization rate");
 
     // Sampling from the probabilities
     SAMPLE_FROM_PROBS(2, which);
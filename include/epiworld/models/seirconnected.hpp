@@ -200,18 +200,18 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
                 auto & v = neighbor.get_virus();
 
                 #ifdef EPI_DEBUG
-                if (nviruses_tmp >= static_cast<int>(m->array_virus_tmp.size()))
+                if (nviruses_tmp >= static_cast<int>(m->get_array_virus_tmp().size()))
                     throw std::logic_error("Trying to add an extra element to a temporal array outside of the range.");
                 #endif
                     
                 /* And it is a function of susceptibility_reduction as well */ 
-                m->array_double_tmp[nviruses_tmp] =
+                m->get_array_double_tmp()[nviruses_tmp] =
                     (1.0 - p->get_susceptibility_reduction(v, m)) * 
                     v->get_prob_infecting(m) * 
                     (1.0 - neighbor.get_transmission_reduction(v, m)) 
                     ; 
             
-                m->array_virus_tmp[nviruses_tmp++] = &(*v);
+                m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
 
             }
 
@@ -226,7 +226,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
                 return;
 
             p->set_virus(
-                *m->array_virus_tmp[which],
+                *m->get_array_virus_tmp()[which],
                 m,
                 ModelSEIRCONN<TSeq>::EXPOSED
                 );
@@ -266,7 +266,7 @@ inline ModelSEIRCONN<TSeq>::ModelSEIRCONN(
                 const auto & v = p->get_virus();
 
                 // Recover
-                m->array_double_tmp[n_events++] = 
+                m->get_array_double_tmp()[n_events++] = 
                     1.0 - (1.0 - v->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(v, m)); 
 
                 #ifdef EPI_DEBUG
@@ -84,11 +84,11 @@ public:
     const auto & v = p->get_virus();
       
     // Die
-    m->array_double_tmp[n_events++] = 
+    m->get_array_double_tmp()[n_events++] = 
       v->get_prob_death(m) * (1.0 - p->get_death_reduction(v, m)); 
     
     // Recover
-    m->array_double_tmp[n_events++] = 
+    m->get_array_double_tmp()[n_events++] = 
       1.0 - (1.0 - v->get_prob_recovery(m)) * (1.0 - p->get_recovery_enhancer(v, m)); 
     
     
@@ -139,10 +139,10 @@ inline ModelSURV<TSeq>::ModelSURV(
 
         // This computes the prob of getting any neighbor variant
         epiworld_fast_uint nviruses_tmp = 0u;
-        for (auto & neighbor: p->get_neighbors()) 
+        for (auto & neighbor: p->get_neighbors_view()) 
         {
                     
-            auto & v = neighbor->get_virus();
+            auto & v = neighbor.get_virus();
 
             if (v == nullptr)
                 continue;
@@ -151,11 +151,11 @@ inline ModelSURV<TSeq>::ModelSURV(
             epiworld_double tmp_transmission = 
                 (1.0 - p->get_susceptibility_reduction(v, m)) * 
                 v->get_prob_infecting(m) * 
-                (1.0 - neighbor->get_transmission_reduction(v, m)) 
+                (1.0 - neighbor.get_transmission_reduction(v, m)) 
                 ; 
         
-            m->array_double_tmp[nviruses_tmp]  = tmp_transmission;
-            m->array_virus_tmp[nviruses_tmp++] = &(*v);
+            m->get_array_double_tmp()[nviruses_tmp]  = tmp_transmission;
+            m->get_array_virus_tmp()[nviruses_tmp++] = &(*v);
         }
 
         // No virus to compute on
@@ -168,7 +168,7 @@ inline ModelSURV<TSeq>::ModelSURV(
         if (which < 0)
             return;
 
-        p->set_virus(*m->array_virus_tmp[which], m); 
+        p->set_virus(*m->get_array_virus_tmp()[which], m); 
         return;
 
     };
@@ -0,0 +1,108 @@
+#ifndef EPIWORLD_NEIGHBORS_BONES_HPP
+#define EPIWORLD_NEIGHBORS_BONES_HPP
+
+template<typename TSeq>
+class Agent;
+
+/**
+ * @brief Set of neighbors of an agent (useful for building iterators)
+ *
+ * @details Unlike `Agent::get_neighbors()`, this class doesn't allocate
+ * memory. It points to the agent's neighbor ids (either stored in the agent
+ * or in the model's CSR arrays) and resolves them to `Agent<TSeq> &` when
+ * iterating. The set is invalidated if the network changes (e.g., rewiring.)
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq>
+class Neighbors {
+private:
+    Agent<TSeq> * population;
+    const size_t * ids;
+    size_t n_neighbors;
+
+public:
+
+    /**
+     * @brief Forward iterator over the neighbors
+     */
+    class iterator {
+    private:
+        Agent<TSeq> * population;
+        const size_t * id;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = Agent<TSeq>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Agent<TSeq> *;
+        using reference         = Agent<TSeq> &;
+
+        iterator(Agent<TSeq> * population_, const size_t * id_) :
+            population(population_), id(id_) {};
+
+        Agent<TSeq> & operator*() const {return population[*id];};
+        Agent<TSeq> * operator->() const {return &population[*id];};
+
+        iterator & operator++() {++id; return *this;};
+        iterator operator++(int) {iterator tmp = *this; ++id; return tmp;};
+
+        bool operator==(const iterator & other) const {return id == other.id;};
+        bool operator!=(const iterator & other) const {return id != other.id;};
+
+    };
+
+    Neighbors() = delete;
+    Neighbors(
+        Agent<TSeq> * population_,
+        const size_t * ids_,
+        size_t n_neighbors_
+        ) : population(population_), ids(ids_), n_neighbors(n_neighbors_) {};
+
+    iterator begin() const;
+    iterator end() const;
+
+    Agent<TSeq> & operator()(size_t i) const;
+    Agent<TSeq> & operator[](size_t i) const;
+
+    size_t size() const noexcept;
+
+};
+
+template<typename TSeq>
+inline typename Neighbors<TSeq>::iterator Neighbors<TSeq>::begin() const
+{
+    return iterator(population, ids);
+}
+
+template<typename TSeq>
+inline typename Neighbors<TSeq>::iterator Neighbors<TSeq>::end() const
+{
+    return iterator(population, ids + n_neighbors);
+}
+
+template<typename TSeq>
+inline Agent<TSeq> & Neighbors<TSeq>::operator()(size_t i) const
+{
+
+    if (i >= n_neighbors)
+        throw std::range_error("Neighbor index out of range.");
+
+    return population[ids[i]];
+
+}
+
+template<typename TSeq>
+inline Agent<TSeq> & Neighbors<TSeq>::operator[](size_t i) const
+{
+    return population[ids[i]];
+}
+
+template<typename TSeq>
+inline size_t Neighbors<TSeq>::size() const noexcept
+{
+    return n_neighbors;
+}
+
+#endif
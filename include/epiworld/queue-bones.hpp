@@ -25,6 +25,22 @@ private:
     Model<TSeq> * model = nullptr;
     int n_in_queue = 0;
 
+    /**
+     * @brief Set of agents in the queue (one bit per agent)
+     * 
+     * @details Bit `i` is on when `active[i] > 0`. Iterating over the set
+     * skips empty 64-agent words, so the cost of a step is proportional to
+     * the number of agents in the queue (plus `n / 64` word checks) instead
+     * of the population size. `active_ids` holds the last listing of the
+     * set (see `get_active_agents()`.)
+     */
+    ///@{
+    std::vector< uint64_t > active_bits;
+    std::vector< size_t > active_ids;
+    void active_add(size_t i);
+    void active_rm(size_t i);
+    ///@}
+
     // Auxiliary variable that checks how many steps
     // left are there
     // int n_steps_left;
@@ -36,6 +52,17 @@ public:
     void operator-=(Agent<TSeq> * p);
     epiworld_fast_int & operator[](epiworld_fast_uint i);
 
+    /**
+     * @brief Ids of the agents in the queue, in increasing order.
+     * 
+     * @details The vector is owned by the queue and is invalidated by
+     * the next call or by changes in the queue. Counts should only be
+     * modified through `operator+=`, `operator-=`, or the events (modifying
+     * them via `operator[]` leaves the set out of sync.)
+     */
+    const std::vector< size_t > & get_active_agents();
+    int size() const noexcept; ///< Number of agents in the queue.
+
     // void initialize(Model<TSeq> * m, Agent<TSeq> * p);
     void reset();
 
@@ -52,30 +79,46 @@ template<typename TSeq>
 inline void Queue<TSeq>::operator+=(Agent<TSeq> * p)
 {
 
-    if (++active[p->id] == 1)
-        n_in_queue++;
+    active_add(p->id);
 
-    for (auto n : (*p->neighbors))
-    {
+    const size_t * neigh_ids = p->neighbors_data();
+    for (size_t i = 0u; i < p->n_neighbors; ++i)
+        active_add(neigh_ids[i]);
 
-        if (++active[n] == 1)
-            n_in_queue++;
+}
 
-    }
+template<typename TSeq>
+inline void Queue<TSeq>::operator-=(Agent<TSeq> * p)
+{
+
+    active_rm(p->id);
+
+    const size_t * neigh_ids = p->neighbors_data();
+    for (size_t i = 0u; i < p->n_neighbors; ++i)
+        active_rm(neigh_ids[i]);
 
 }
 
 template<typename TSeq>
-inline void Queue<TSeq>::operator-=(Agent<TSeq> * p)
+inline void Queue<TSeq>::active_add(size_t i)
 {
 
-    if (--active[p->id] == 0)
-        n_in_queue--;
+    if (++active[i] == 1)
+    {
+        n_in_queue++;
+        active_bits[i >> 6] |= (static_cast< uint64_t >(1u) << (i & 63u));
+    }
+
+}
 
-    for (auto n : (*p->neighbors))
+template<typename TSeq>
+inline void Queue<TSeq>::active_rm(size_t i)
+{
+
+    if (--active[i] == 0)
     {
-        if (--active[n] == 0)
-            n_in_queue--;
+        n_in_queue--;
+        active_bits[i >> 6] &= ~(static_cast< uint64_t >(1u) << (i & 63u));
     }
 
 }
@@ -86,6 +129,46 @@ inline epiworld_fast_int & Queue<TSeq>::operator[](epiworld_fast_uint i)
     return active[i];
 }
 
+template<typename TSeq>
+inline const std::vector< size_t > & Queue<TSeq>::get_active_agents()
+{
+
+    active_ids.clear();
+
+    for (size_t w = 0u; w < active_bits.size(); ++w)
+    {
+
+        uint64_t word = active_bits[w];
+
+        // Visiting the bits on, lowest first
+        while (word != 0u)
+        {
+
+            #if defined(__GNUC__) || defined(__clang__)
+            size_t b = static_cast< size_t >(__builtin_ctzll(word));
+            #else
+            size_t b = 0u;
+            while (((word >> b) & 1u) == 0u)
+                ++b;
+            #endif
+
+            active_ids.push_back((w << 6) + b);
+            word &= word - 1u;
+
+        }
+
+    }
+
+    return active_ids;
+
+}
+
+template<typename TSeq>
+inline int Queue<TSeq>::size() const noexcept
+{
+    return n_in_queue;
+}
+
 template<typename TSeq>
 inline void Queue<TSeq>::reset()
 {
@@ -96,11 +179,15 @@ inline void Queue<TSeq>::reset()
         for (auto & q : this->active)
             q = 0;
 
+        for (auto & w : this->active_bits)
+            w = 0u;
+
         n_in_queue = 0;
         
     }
 
     active.resize(model->size(), 0);
+    active_bits.resize((model->size() + 63u) / 64u, 0u);
 
 }
 
@@ -17,6 +17,29 @@ inline void rewire_degseq(
     epiworld_double proportion
     );
 
+/**
+ * @brief Picks an ego for `rewire_degseq()`
+ * 
+ * @param weights Cumulative probabilities (non-decreasing.)
+ * @param prob Uniform draw.
+ * @return The first position `i` with `prob <= weights[i]` (the last position
+ * if there is none,) found by binary search.
+ */
+inline int rewire_degseq_pick(
+    const std::vector< epiworld_double > & weights,
+    epiworld_double prob
+    )
+{
+
+    auto it = std::lower_bound(weights.begin(), weights.end(), prob);
+
+    if (it == weights.end())
+        return static_cast< int >(weights.size()) - 1;
+
+    return static_cast< int >(it - weights.begin());
+
+}
+
 template<typename TSeq = EPI_DEFAULT_TSEQ>
 inline void rewire_degseq(
     std::vector< Agent<TSeq> > * agents,
@@ -28,7 +51,7 @@ inline void rewire_degseq(
     #ifdef EPI_DEBUG
     std::vector< int > _degree0(agents->size(), 0);
     for (size_t i = 0u; i < _degree0.size(); ++i)
-        _degree0[i] = model->get_agents()[i].get_neighbors().size();
+        _degree0[i] = model->get_agents()[i].get_n_neighbors();
     #endif
 
     // Identifying individuals with degree > 0
@@ -38,11 +61,11 @@ inline void rewire_degseq(
     
     for (epiworld_fast_uint i = 0u; i < agents->size(); ++i)
     {
-        if (agents->operator[](i).get_neighbors().size() > 0u)
+        if (agents->operator[](i).get_n_neighbors() > 0u)
         {
             non_isolates.push_back(i);
             epiworld_double wtemp = static_cast<epiworld_double>(
-                agents->operator[](i).get_neighbors().size()
+                agents->operator[](i).get_n_neighbors()
                 );
             weights.push_back(wtemp);
             nedges += wtemp;
@@ -62,29 +85,13 @@ inline void rewire_degseq(
 
     // Only swap if needed
     epiworld_fast_uint N = non_isolates.size();
-    epiworld_double prob;
     int nrewires = floor(proportion * nedges);
     while (nrewires-- > 0)
     {
 
         // Picking egos
-        prob = model->runif();
-        int id0 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id0 = i;
-                break;
-            }
-
-        prob = model->runif();
-        int id1 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id1 = i;
-                break;
-            }
+        int id0 = rewire_degseq_pick(weights, model->runif());
+        int id1 = rewire_degseq_pick(weights, model->runif());
 
         // Correcting for under or overflow.
         if (id1 == id0)
@@ -105,11 +112,7 @@ inline void rewire_degseq(
         // end as well, since we are dealing withi an undirected graph
         
         // Finding what neighbour is id0
-        model->get_agents()[id0].swap_neighbors(
-            model->get_agents()[id1],
-            id01,
-            id11
-            );
+        p0.swap_neighbors(p1, id01, id11);
         
 
     }
@@ -190,7 +193,6 @@ inline void rewire_degseq(
 
     // Only swap if needed
     epiworld_fast_uint N = non_isolates.size();
-    epiworld_double prob;
     int nrewires = floor(proportion * nedges / (
         agents->is_directed() ? 1.0 : 2.0
     ));
@@ -199,23 +201,8 @@ inline void rewire_degseq(
     {
 
         // Picking egos
-        prob = model->runif();
-        int id0 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id0 = i;
-                break;
-            }
-
-        prob = model->runif();
-        int id1 = N - 1;
-        for (epiworld_fast_uint i = 0u; i < N; ++i)
-            if (prob <= weights[i])
-            {
-                id1 = i;
-                break;
-            }
+        int id0 = rewire_degseq_pick(weights, model->runif());
+        int id1 = rewire_degseq_pick(weights, model->runif());
 
         // Correcting for under or overflow.
         if (id1 == id0)
@@ -526,4 +513,346 @@ inline AdjList rgraph_blocked(
 
 }
 
+/**
+ * @brief Geometric skipping over a sequence of Bernoulli trials
+ * 
+ * @details Calls `fun(k)` for each success `k` in `[0, ntrials)`, where each
+ * trial succeeds with probability `p`. The gaps between successes are drawn
+ * from a geometric distribution (Batagelj and Brandes, 2005,) so the cost is
+ * proportional to the number of successes instead of `ntrials`.
+ */
+template<typename TSeq, typename TFun>
+inline void rgraph_geometric_skip(
+    uint64_t ntrials,
+    epiworld_double p,
+    Model<TSeq> & model,
+    TFun fun
+) {
+
+    if ((p <= 0.0) || (ntrials == 0u))
+        return;
+
+    if (p >= 1.0)
+    {
+        for (uint64_t k = 0u; k < ntrials; ++k)
+            fun(k);
+
+        return;
+    }
+
+    double logq = std::log(1.0 - static_cast< double >(p));
+    uint64_t k = 0u;
+    while (true)
+    {
+
+        double skip = std::floor(std::log(1.0 - model.runif()) / logq);
+        if (skip >= static_cast< double >(ntrials - k))
+            break;
+
+        k += static_cast< uint64_t >(skip);
+        fun(k);
+
+        if (++k >= ntrials)
+            break;
+
+    }
+
+}
+
+/**
+ * @brief Pairs `(i, j)` within `n` nodes for `rgraph_geometric_skip()`
+ * 
+ * @details Undirected pairs are enumerated as `i > j` (`n(n-1)/2` pairs),
+ * directed pairs as every `i != j` (`n(n-1)` pairs.)
+ */
+inline void rgraph_pair_within(
+    uint64_t k,
+    uint64_t n,
+    bool directed,
+    uint64_t * i,
+    uint64_t * j
+) {
+
+    if (directed)
+    {
+        *i = k / (n - 1u);
+        *j = k % (n - 1u);
+        if (*j >= *i)
+            ++(*j);
+
+        return;
+    }
+
+    uint64_t v = static_cast< uint64_t >(
+        (1.0 + std::sqrt(1.0 + 8.0 * static_cast< double >(k))) / 2.0
+    );
+
+    // Correcting for rounding error
+    while ((v * (v - 1u) / 2u) > k)
+        --v;
+
+    while (((v + 1u) * v / 2u) <= k)
+        ++v;
+
+    *i = v;
+    *j = k - v * (v - 1u) / 2u;
+
+}
+
+/**
+ * @brief Erdos-Renyi G(n, p) network by geometric skipping
+ * 
+ * @details Same model as `rgraph_bernoulli()`, but every pair is considered
+ * exactly once (no duplicated edges nor loops) and the cost is proportional
+ * to the number of edges. The edges are written to `source` and `target`,
+ * which can be passed to `Model::agents_from_edgelist()`.
+ * 
+ * @param n Number of nodes.
+ * @param p Probability of an edge between two nodes.
+ * @param directed When `false`, edges satisfy `source > target`.
+ * @param model Model used to draw the random numbers.
+ * @param source,target Vectors where to write the edges.
+ */
+template<typename TSeq>
+inline void rgraph_bernoulli_skip(
+    epiworld_fast_uint n,
+    epiworld_double p,
+    bool directed,
+    Model<TSeq> & model,
+    std::vector< int > & source,
+    std::vector< int > & target
+) {
+
+    source.clear();
+    target.clear();
+
+    if (n < 2u)
+        return;
+
+    uint64_t n64 = static_cast< uint64_t >(n);
+    uint64_t npairs = n64 * (n64 - 1u) / (directed ? 1u : 2u);
+
+    size_t expected = static_cast< size_t >(
+        static_cast< double >(npairs) * std::min(static_cast< double >(p), 1.0)
+    );
+    source.reserve(expected + expected / 10u);
+    target.reserve(expected + expected / 10u);
+
+    rgraph_geometric_skip(npairs, p, model, [&](uint64_t k) -> void {
+        uint64_t i, j;
+        rgraph_pair_within(k, n64, directed, &i, &j);
+        source.push_back(static_cast< int >(i));
+        target.push_back(static_cast< int >(j));
+    });
+
+}
+
+/**
+ * @brief Stochastic block model driven by a contact matrix
+ * 
+ * @details Nodes are split in consecutive blocks (the first `block_sizes[0]`
+ * nodes are block 0, and so on.) As in `ModelSIRMixing`, `contact_matrix`
+ * is stored column-major, and entry `(i, j)` is the proportion of the
+ * contacts of block `i` that are with block `j`. The probability of an edge
+ * between a node in `i` and one in `j` is thus
+ * `avg_degree * contact_matrix(i, j) / block_sizes[j]` (capped at one,) and
+ * undirected networks use the average of `(i, j)` and `(j, i)`. Each pair of
+ * blocks is sampled with `rgraph_geometric_skip()`.
+ * 
+ * @param block_sizes Number of nodes in each block.
+ * @param contact_matrix Contact matrix (column-major.)
+ * @param avg_degree Expected number of contacts per node.
+ * @param directed When `false`, edges satisfy `source > target`.
+ * @param model Model used to draw the random numbers.
+ * @param source,target Vectors where to write the edges.
+ */
+template<typename TSeq>
+inline void rgraph_sbm(
+    const std::vector< size_t > & block_sizes,
+    const std::vector< epiworld_double > & contact_matrix,
+    epiworld_double avg_degree,
+    bool directed,
+    Model<TSeq> & model,
+    std::vector< int > & source,
+    std::vector< int > & target
+) {
+
+    size_t nblocks = block_sizes.size();
+    if (contact_matrix.size() != (nblocks * nblocks))
+        throw std::length_error(
+            "The contact matrix must be of size nblocks x nblocks. " +
+            std::to_string(contact_matrix.size()) + " != " +
+            std::to_string(nblocks * nblocks) + "."
+        );
+
+    for (auto c : contact_matrix)
+        if (c < 0.0)
+            throw std::range_error("The contact matrix must be non-negative.");
+
+    if (avg_degree < 0.0)
+        throw std::range_error("The average degree must be non-negative.");
+
+    source.clear();
+    target.clear();
+
+    std::vector< uint64_t > start(nblocks + 1u, 0u);
+    for (size_t b = 0u; b < nblocks; ++b)
+        start[b + 1u] = start[b] + block_sizes[b];
+
+    // Probability of an edge from a node in i to a node in j
+    auto prob = [&](size_t i, size_t j) -> epiworld_double {
+        if (block_sizes[j] == 0u)
+            return 0.0;
+
+        return avg_degree * contact_matrix[j * nblocks + i] /
+            static_cast< epiworld_double >(block_sizes[j]);
+    };
+
+    for (size_t i = 0u; i < nblocks; ++i)
+    {
+
+        for (size_t j = (directed ? 0u : i); j < nblocks; ++j)
+        {
+
+            epiworld_double p = directed ?
+                prob(i, j) : (prob(i, j) + prob(j, i)) / 2.0;
+
+            uint64_t ni = block_sizes[i];
+            uint64_t nj = block_sizes[j];
+
+            if (i == j)
+            {
+
+                if (ni < 2u)
+                    continue;
+
+                uint64_t npairs = ni * (ni - 1u) / (directed ? 1u : 2u);
+                rgraph_geometric_skip(npairs, p, model, [&](uint64_t k) -> void {
+                    uint64_t a, b;
+                    rgraph_pair_within(k, ni, directed, &a, &b);
+                    source.push_back(static_cast< int >(start[i] + a));
+                    target.push_back(static_cast< int >(start[i] + b));
+                });
+
+            }
+            else
+            {
+
+                // Undirected edges go from the later block (j > i)
+                rgraph_geometric_skip(ni * nj, p, model, [&](uint64_t k) -> void {
+                    uint64_t a = start[i] + k / nj;
+                    uint64_t b = start[j] + k % nj;
+                    source.push_back(static_cast< int >(directed ? a : b));
+                    target.push_back(static_cast< int >(directed ? b : a));
+                });
+
+            }
+
+        }
+
+    }
+
+}
+
+/**
+ * @brief Chung-Lu network with a given expected degree sequence
+ * 
+ * @details Nodes `i` and `j` are connected with probability
+ * `min(w[i] * w[j] / sum(w), 1)`, where `w` are the expected degrees. Nodes
+ * are visited in decreasing order of `w`, so the probabilities along each
+ * row are non-increasing and the candidates can be skipped geometrically
+ * and then thinned (Miller and Hagberg, 2011.) The cost is proportional to
+ * the number of nodes plus the number of edges. The network is undirected
+ * (edges satisfy `source > target`.)
+ * 
+ * @param degrees Expected degree of each node.
+ * @param model Model used to draw the random numbers.
+ * @param source,target Vectors where to write the edges.
+ */
+template<typename TSeq>
+inline void rgraph_chung_lu(
+    const std::vector< epiworld_double > & degrees,
+    Model<TSeq> & model,
+    std::vector< int > & source,
+    std::vector< int > & target
+) {
+
+    source.clear();
+    target.clear();
+
+    size_t n = degrees.size();
+    double total = 0.0;
+    for (auto d : degrees)
+    {
+
+        if (d < 0.0)
+            throw std::range_error("The expected degrees must be non-negative.");
+
+        total += static_cast< double >(d);
+
+    }
+
+    if (total <= 0.0)
+        return;
+
+    std::vector< size_t > order(n);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&degrees](size_t a, size_t b) {
+        return degrees[a] > degrees[b];
+    });
+
+    std::vector< double > w(n);
+    for (size_t i = 0u; i < n; ++i)
+        w[i] = static_cast< double >(degrees[order[i]]);
+
+    size_t expected = static_cast< size_t >(total / 2.0);
+    source.reserve(expected + expected / 10u);
+    target.reserve(expected + expected / 10u);
+
+    for (size_t u = 0u; (u + 1u) < n; ++u)
+    {
+
+        if (w[u] <= 0.0)
+            break;
+
+        size_t v = u + 1u;
+        double p = std::min(w[u] * w[v] / total, 1.0);
+        while ((v < n) && (p > 0.0))
+        {
+
+            if (p < 1.0)
+            {
+
+                double skip = std::floor(
+                    std::log(1.0 - model.runif()) / std::log(1.0 - p)
+                );
+
+                if (skip >= static_cast< double >(n - v))
+                    break;
+
+                v += static_cast< size_t >(skip);
+
+            }
+
+            // Thinning, since the probability decreases along the row
+            double q = std::min(w[u] * w[v] / total, 1.0);
+            if (model.runif() < (q / p))
+            {
+
+                size_t a = order[u];
+                size_t b = order[v];
+                source.push_back(static_cast< int >(std::max(a, b)));
+                target.push_back(static_cast< int >(std::min(a, b)));
+
+            }
+
+            p = q;
+            ++v;
+
+        }
+
+    }
+
+}
+
 #endif
@@ -0,0 +1,134 @@
+#ifndef EPIWORLD_RANDOM_PHILOX_HPP
+#define EPIWORLD_RANDOM_PHILOX_HPP
+
+/**
+ * @brief Counter-based random number engine (Philox4x32-10)
+ *
+ * @details Implements the Philox4x32-10 generator by Salmon et al. (2011)
+ * "Parallel random numbers: as easy as 1, 2, 3". Each output block is a
+ * pure function of a 64-bit key (the seed) and a 128-bit counter, so
+ * independent streams can be addressed directly without sharing state.
+ * The first counter word indexes the blocks within a stream (four numbers
+ * per block,) while the other three words identify the stream (see
+ * `set_stream()`.)
+ *
+ * The class satisfies the requirements of a `UniformRandomBitGenerator`,
+ * so it can be used with the distributions in `<random>`.
+ */
+class Philox4x32 {
+public:
+
+    typedef uint32_t result_type;
+
+    static constexpr result_type min() {return 0u;};
+    static constexpr result_type max() {return 0xFFFFFFFFu;};
+
+    Philox4x32(uint64_t s = 0u) {seed(s);};
+
+    /**
+     * @brief Sets the key and goes back to the first stream.
+     * @param s Seed.
+     */
+    void seed(uint64_t s);
+
+    /**
+     * @brief Moves to the beginning of the stream `(c1, c2, c3)`.
+     */
+    void set_stream(uint32_t c1, uint32_t c2, uint32_t c3);
+
+    result_type operator()();
+
+    /**
+     * @brief Philox4x32-10 bijection.
+     *
+     * @param ctr Counter (modified in place to hold the output.)
+     * @param key Key.
+     */
+    static void block(uint32_t * ctr, const uint32_t * key);
+
+private:
+
+    uint32_t key[2];
+    uint32_t ctr[4];
+    uint32_t out[4];
+    unsigned int out_idx = 4u; ///< Next element of `out` (4 means empty.)
+
+};
+
+inline void Philox4x32::seed(uint64_t s)
+{
+
+    key[0] = static_cast< uint32_t >(s);
+    key[1] = static_cast< uint32_t >(s >> 32);
+
+    set_stream(0u, 0u, 0u);
+
+}
+
+inline void Philox4x32::set_stream(uint32_t c1, uint32_t c2, uint32_t c3)
+{
+
+    ctr[0] = 0u;
+    ctr[1] = c1;
+    ctr[2] = c2;
+    ctr[3] = c3;
+
+    out_idx = 4u;
+
+}
+
+inline Philox4x32::result_type Philox4x32::operator()()
+{
+
+    if (out_idx == 4u)
+    {
+
+        for (size_t i = 0u; i < 4u; ++i)
+            out[i] = ctr[i];
+
+        block(&out[0u], &key[0u]);
+
+        ++ctr[0u];
+        out_idx = 0u;
+
+    }
+
+    return out[out_idx++];
+
+}
+
+inline void Philox4x32::block(uint32_t * ctr, const uint32_t * key)
+{
+
+    const uint64_t M0 = 0xD2511F53u;
+    const uint64_t M1 = 0xCD9E8D57u;
+    const uint32_t W0 = 0x9E3779B9u;
+    const uint32_t W1 = 0xBB67AE85u;
+
+    uint32_t k0 = key[0u];
+    uint32_t k1 = key[1u];
+
+    for (int r = 0; r < 10; ++r)
+    {
+
+        uint64_t p0 = M0 * static_cast< uint64_t >(ctr[0u]);
+        uint64_t p1 = M1 * static_cast< uint64_t >(ctr[2u]);
+
+        uint32_t c0 = static_cast< uint32_t >(p1 >> 32) ^ ctr[1u] ^ k0;
+        uint32_t c1 = static_cast< uint32_t >(p1);
+        uint32_t c2 = static_cast< uint32_t >(p0 >> 32) ^ ctr[3u] ^ k1;
+        uint32_t c3 = static_cast< uint32_t >(p0);
+
+        ctr[0u] = c0;
+        ctr[1u] = c1;
+        ctr[2u] = c2;
+        ctr[3u] = c3;
+
+        k0 += W0;
+        k1 += W1;
+
+    }
+
+}
+
+#endif
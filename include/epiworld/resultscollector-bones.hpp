@@ -0,0 +1,142 @@
+#ifndef EPIWORLD_RESULTSCOLLECTOR_BONES_HPP
+#define EPIWORLD_RESULTSCOLLECTOR_BONES_HPP
+
+template<typename TSeq>
+class Model;
+
+/**
+ * @brief Collects the results of `Model::run_multiple()` in memory
+ *
+ * @details An alternative to `make_save_run()`, which writes a set of files
+ * per replicate. The collector preallocates one slot per replicate (indexed
+ * by the simulation id,) and each call to the function returned by
+ * `make_fun()` only writes to the slot of its replicate, so threads can
+ * store their results without locks. Once `run_multiple()` is done, the
+ * results can be retrieved as columns (`get_hist_total()`,
+ * `get_transmissions()`, `get_reproductive_number()`) or written to a
+ * single file per type (`write()`), with the simulation id as the first
+ * column.
+ *
+ * @code
+ * ResultsCollector<> collector(model, 1000);
+ * model.run_multiple(100, 1000, 1231, collector.make_fun(), true, true, 4);
+ * collector.write("total_hist.csv", "transmission.csv", "reproductive.csv");
+ * @endcode
+ *
+ * @tparam TSeq
+ */
+template<typename TSeq = EPI_DEFAULT_TSEQ>
+class ResultsCollector {
+private:
+
+    size_t nexperiments;
+    bool total_hist;
+    bool transmission;
+    bool reproductive;
+
+    std::vector< std::string > states_labels;
+
+    /**
+     * @name Columns of each replicate (indexed by simulation id)
+     */
+    ///@{
+    std::vector< int > collected; ///< 1 if the replicate was collected.
+
+    std::vector< std::vector< int > > hist_total_date;
+    std::vector< std::vector< int > > hist_total_nviruses_active;
+    std::vector< std::vector< epiworld_fast_uint > > hist_total_state;
+    std::vector< std::vector< int > > hist_total_counts;
+
+    std::vector< std::vector< int > > transmission_date;
+    std::vector< std::vector< int > > transmission_source;
+    std::vector< std::vector< int > > transmission_target;
+    std::vector< std::vector< int > > transmission_virus;
+    std::vector< std::vector< int > > transmission_source_exposure_date;
+
+    std::vector< std::vector< int > > rt_virus;
+    std::vector< std::vector< int > > rt_source;
+    std::vector< std::vector< int > > rt_source_exposure_date;
+    std::vector< std::vector< int > > rt_counts;
+    ///@}
+
+public:
+
+    ResultsCollector() = delete;
+
+    /**
+     * @param model Model to be run (used to retrieve the state labels.)
+     * @param nexperiments Number of replicates.
+     * @param total_hist,transmission,reproductive What to collect.
+     */
+    ResultsCollector(
+        Model<TSeq> & model,
+        size_t nexperiments,
+        bool total_hist   = true,
+        bool transmission = true,
+        bool reproductive = true
+    );
+
+    /**
+     * @brief Stores the results of the replicate `sim_id`
+     *
+     * @details Can be called concurrently as long as `sim_id` differs.
+     */
+    void collect(size_t sim_id, Model<TSeq> * m);
+
+    /**
+     * @brief Function to pass to `Model::run_multiple()`
+     *
+     * @details The function refers to this object, which must outlive
+     * the call to `run_multiple()`.
+     */
+    std::function<void(size_t,Model<TSeq>*)> make_fun();
+
+    size_t size() const noexcept; ///< Number of replicates.
+    size_t get_n_collected() const; ///< Number of replicates collected.
+
+    /**
+     * @name Retrieve the results
+     *
+     * @details Results are stacked by simulation id (replicates that were
+     * not collected are skipped.) The columns match those written by
+     * `DataBase::write_data()`.
+     */
+    ///@{
+    void get_hist_total(
+        std::vector< int > & sim_id,
+        std::vector< int > & date,
+        std::vector< std::string > & state,
+        std::vector< int > & counts
+    ) const;
+
+    void get_transmissions(
+        std::vector< int > & sim_id,
+        std::vector< int > & date,
+        std::vector< int > & source,
+        std::vector< int > & target,
+        std::vector< int > & virus,
+        std::vector< int > & source_exposure_date
+    ) const;
+
+    void get_reproductive_number(
+        std::vector< int > & sim_id,
+        std::vector< int > & virus,
+        std::vector< int > & source,
+        std::vector< int > & source_exposure_date,
+        std::vector< int > & rt
+    ) const;
+
+    /**
+     * @param fn_total_hist,fn_transmission,fn_reproductive_number Files
+     * where to write the results (empty strings are skipped.)
+     */
+    void write(
+        std::string fn_total_hist,
+        std::string fn_transmission,
+        std::string fn_reproductive_number
+    ) const;
+    ///@}
+
+};
+
+#endif
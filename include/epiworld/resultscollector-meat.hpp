@@ -0,0 +1,341 @@
+#ifndef EPIWORLD_RESULTSCOLLECTOR_MEAT_HPP
+#define EPIWORLD_RESULTSCOLLECTOR_MEAT_HPP
+
+template<typename TSeq>
+inline ResultsCollector<TSeq>::ResultsCollector(
+    Model<TSeq> & model,
+    size_t nexperiments,
+    bool total_hist,
+    bool transmission,
+    bool reproductive
+) : nexperiments(nexperiments), total_hist(total_hist),
+    transmission(transmission), reproductive(reproductive),
+    states_labels(model.get_states()), collected(nexperiments, 0)
+{
+
+    if (total_hist)
+    {
+        hist_total_date.resize(nexperiments);
+        hist_total_nviruses_active.resize(nexperiments);
+        hist_total_state.resize(nexperiments);
+        hist_total_counts.resize(nexperiments);
+    }
+
+    if (transmission)
+    {
+        transmission_date.resize(nexperiments);
+        transmission_source.resize(nexperiments);
+        transmission_target.resize(nexperiments);
+        transmission_virus.resize(nexperiments);
+        transmission_source_exposure_date.resize(nexperiments);
+    }
+
+    if (reproductive)
+    {
+        rt_virus.resize(nexperiments);
+        rt_source.resize(nexperiments);
+        rt_source_exposure_date.resize(nexperiments);
+        rt_counts.resize(nexperiments);
+    }
+
+}
+
+template<typename TSeq>
+inline void ResultsCollector<TSeq>::collect(size_t sim_id, Model<TSeq> * m)
+{
+
+    if (sim_id >= nexperiments)
+        throw std::range_error(
+            "The simulation id " + std::to_string(sim_id) +
+            " is out of range. The collector has " +
+            std::to_string(nexperiments) + " slots."
+        );
+
+    const DataBase<TSeq> & db = m->get_db();
+
+    if (total_hist)
+    {
+        hist_total_date[sim_id]            = db.hist_total_date;
+        hist_total_nviruses_active[sim_id] = db.hist_total_nviruses_active;
+        hist_total_state[sim_id]           = db.hist_total_state;
+        hist_total_counts[sim_id]          = db.hist_total_counts;
+    }
+
+    if (transmission)
+    {
+        // Spilled records included
+        db.get_transmissions(
+            transmission_date[sim_id],
+            transmission_source[sim_id],
+            transmission_target[sim_id],
+            transmission_virus[sim_id],
+            transmission_source_exposure_date[sim_id]
+        );
+    }
+
+    if (reproductive)
+    {
+
+        db.reproductive_number(
+            rt_virus[sim_id],
+            rt_source[sim_id],
+            rt_source_exposure_date[sim_id],
+            rt_counts[sim_id]
+        );
+
+    }
+
+    collected[sim_id] = 1;
+
+}
+
+template<typename TSeq>
+inline std::function<void(size_t,Model<TSeq>*)>
+ResultsCollector<TSeq>::make_fun()
+{
+
+    return [this](size_t sim_id, Model<TSeq> * m) -> void {
+        this->collect(sim_id, m);
+    };
+
+}
+
+template<typename TSeq>
+inline size_t ResultsCollector<TSeq>::size() const noexcept
+{
+    return nexperiments;
+}
+
+template<typename TSeq>
+inline size_t ResultsCollector<TSeq>::get_n_collected() const
+{
+
+    size_t n = 0u;
+    for (auto c : collected)
+        n += static_cast< size_t >(c);
+
+    return n;
+
+}
+
+template<typename TSeq>
+inline void ResultsCollector<TSeq>::get_hist_total(
+    std::vector< int > & sim_id,
+    std::vector< int > & date,
+    std::vector< std::string > & state,
+    std::vector< int > & counts
+) const
+{
+
+    if (!total_hist)
+        throw std::logic_error("The total history was not collected.");
+
+    sim_id.clear();
+    date.clear();
+    state.clear();
+    counts.clear();
+
+    for (size_t i = 0u; i < nexperiments; ++i)
+    {
+
+        if (!collected[i])
+            continue;
+
+        for (size_t j = 0u; j < hist_total_date[i].size(); ++j)
+        {
+            sim_id.push_back(static_cast< int >(i));
+            date.push_back(hist_total_date[i][j]);
+            state.push_back(states_labels[hist_total_state[i][j]]);
+            counts.push_back(hist_total_counts[i][j]);
+        }
+
+    }
+
+}
+
+template<typename TSeq>
+inline void ResultsCollector<TSeq>::get_transmissions(
+    std::vector< int > & sim_id,
+    std::vector< int > & date,
+    std::vector< int > & source,
+    std::vector< int > & target,
+    std::vector< int > & virus,
+    std::vector< int > & source_exposure_date
+) const
+{
+
+    if (!transmission)
+        throw std::logic_error("The transmissions were not collected.");
+
+    sim_id.clear();
+    date.clear();
+    source.clear();
+    target.clear();
+    virus.clear();
+    source_exposure_date.clear();
+
+    for (size_t i = 0u; i < nexperiments; ++i)
+    {
+
+        if (!collected[i])
+            continue;
+
+        sim_id.insert(
+            sim_id.end(), transmission_date[i].size(), static_cast< int >(i)
+        );
+
+        #define EPI_APPEND_(a, b) a.insert(a.end(), b[i].begin(), b[i].end());
+        EPI_APPEND_(date, transmission_date)
+        EPI_APPEND_(source, transmission_source)
+        EPI_APPEND_(target, transmission_target)
+        EPI_APPEND_(virus, transmission_virus)
+        EPI_APPEND_(source_exposure_date, transmission_source_exposure_date)
+        #undef EPI_APPEND_
+
+    }
+
+}
+
+template<typename TSeq>
+inline void ResultsCollector<TSeq>::get_reproductive_number(
+    std::vector< int > & sim_id,
+    std::vector< int > & virus,
+    std::vector< int > & source,
+    std::vector< int > & source_exposure_date,
+    std::vector< int > & rt
+) const
+{
+
+    if (!reproductive)
+        throw std::logic_error("The reproductive number was not collected.");
+
+    sim_id.clear();
+    virus.clear();
+    source.clear();
+    source_exposure_date.clear();
+    rt.clear();
+
+    for (size_t i = 0u; i < nexperiments; ++i)
+    {
+
+        if (!collected[i])
+            continue;
+
+        sim_id.insert(
+            sim_id.end(), rt_virus[i].size(), static_cast< int >(i)
+        );
+
+        #define EPI_APPEND_(a, b) a.insert(a.end(), b[i].begin(), b[i].end());
+        EPI_APPEND_(virus, rt_virus)
+        EPI_APPEND_(source, rt_source)
+        EPI_APPEND_(source_exposure_date, rt_source_exposure_date)
+        EPI_APPEND_(rt, rt_counts)
+        #undef EPI_APPEND_
+
+    }
+
+}
+
+template<typename TSeq>
+inline void ResultsCollector<TSeq>::write(
+    std::string fn_total_hist,
+    std::string fn_transmission,
+    std::string fn_reproductive_number
+) const
+{
+
+    auto open_file = [](std::string & fn) -> std::ofstream {
+
+        std::ofstream file(fn, std::ios_base::out);
+
+        if (!file)
+            throw std::runtime_error(
+                "Could not open file \"" + fn + "\" for writing."
+            );
+
+        return file;
+
+    };
+
+    if ((fn_total_hist != "") && total_hist)
+    {
+
+        std::ofstream file_total = open_file(fn_total_hist);
+
+        file_total << "sim_id " << "date " << "nviruses " << "state " <<
+            "counts\n";
+
+        for (size_t i = 0u; i < nexperiments; ++i)
+        {
+
+            if (!collected[i])
+                continue;
+
+            for (size_t j = 0u; j < hist_total_date[i].size(); ++j)
+                file_total <<
+                    i << " " <<
+                    hist_total_date[i][j] << " " <<
+                    hist_total_nviruses_active[i][j] << " \"" <<
+                    states_labels[hist_total_state[i][j]] << "\" " <<
+                    hist_total_counts[i][j] << "\n";
+
+        }
+
+    }
+
+    if ((fn_transmission != "") && transmission)
+    {
+
+        std::ofstream file_transmission = open_file(fn_transmission);
+
+        file_transmission << "sim_id " << "date " << "virus_id " <<
+            "source_exposure_date " << "source " << "target\n";
+
+        for (size_t i = 0u; i < nexperiments; ++i)
+        {
+
+            if (!collected[i])
+                continue;
+
+            for (size_t j = 0u; j < transmission_date[i].size(); ++j)
+                file_transmission <<
+                    i << " " <<
+                    transmission_date[i][j] << " " <<
+                    transmission_virus[i][j] << " " <<
+                    transmission_source_exposure_date[i][j] << " " <<
+                    transmission_source[i][j] << " " <<
+                    transmission_target[i][j] << "\n";
+
+        }
+
+    }
+
+    if ((fn_reproductive_number != "") && reproductive)
+    {
+
+        std::ofstream file_rt = open_file(fn_reproductive_number);
+
+        file_rt << "sim_id " << "virus_id " << "source " <<
+            "source_exposure_date " << "rt\n";
+
+        for (size_t i = 0u; i < nexperiments; ++i)
+        {
+
+            if (!collected[i])
+                continue;
+
+            for (size_t j = 0u; j < rt_virus[i].size(); ++j)
+                file_rt <<
+                    i << " " <<
+                    rt_virus[i][j] << " " <<
+                    rt_source[i][j] << " " <<
+                    rt_source_exposure_date[i][j] << " " <<
+                    rt_counts[i][j] << "\n";
+
+        }
+
+    }
+
+}
+
+#endif
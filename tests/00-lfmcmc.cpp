@@ -1,47 +1,8 @@
 #include "tests.hpp"
 #include "../include/epiworld/math/lfmcmc.hpp"
 
-typedef std::vector<epiworld_double> vec_double;
-
 using namespace epiworld;
 
-vec_double simfun(const vec_double & p, LFMCMC<vec_double> * m)
-{
-
-    vec_double res;
-    for (size_t i = 0; i < 1000; ++i)
-        res.push_back(m->rnorm(p[0], p[1]));
-
-    return res;
-}
-
-void summary_fun(vec_double & res, const vec_double & p, LFMCMC<vec_double> * m)
-{
-
-    if (res.size() == 0u)
-        res.resize(2u);
-
-    epiworld_double * mean = &res[0u];
-    epiworld_double * sd   = &res[1u];
-    epiworld_double n      = static_cast<epiworld_double>(p.size());
-
-    *mean = 0.0;
-    for (auto & v : p)
-        *mean += (v/n);
-
-    *sd = 0.0;
-    for (auto & v: p)
-        *sd += (std::pow(*mean - v, 2.0)/(n - 1));
-
-    *sd = std::sqrt(*sd);
-
-    auto params = m->get_current_proposed_params();
-
-    // printf("{mu, sigma} = {% 4.2f, % 4.2f}; ", params[0u], params[1u]);
-    // printf("{mean, sd} =  {% 4.2f, % 4.2f}\n", *mean, *sd);
-
-}
-
 EPIWORLD_TEST_CASE("LFMCMC", "[Basic example]") {
 
     auto rand = std::make_shared<std::mt19937>();
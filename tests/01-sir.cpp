@@ -70,6 +70,15 @@ EPIWORLD_TEST_CASE("SIR", "[SIR]") {
         if (v < 0.0 | v > 1.0)
             out_of_range_2++;
 
+    // The queue's set of agents should match the counts
+    auto & queue_0 = model_0.get_queue();
+    std::vector< size_t > active_expected;
+    for (size_t i = 0u; i < model_0.size(); ++i)
+        if (queue_0[i] > 0)
+            active_expected.push_back(i);
+
+    std::vector< size_t > active_0 = queue_0.get_active_agents();
+
     std::vector< epiworld_double > tmat_expected = {0.962440431, 0.0, 0.0, 0.0386752182, 0.704328, 0.0, 3.3772063e-05, 0.298277199, 1.0};
 
     #ifdef CATCH_CONFIG_MAIN
@@ -79,6 +88,8 @@ EPIWORLD_TEST_CASE("SIR", "[SIR]") {
     REQUIRE_THAT(h_0, Catch::Equals(h_1));
     REQUIRE_THAT(h_0, Catch::Equals(h_2));
     REQUIRE(out_of_range_0 == 0);
+    REQUIRE_THAT(active_0, Catch::Equals(active_expected));
+    REQUIRE(queue_0.size() == static_cast< int >(active_expected.size()));
     REQUIRE(out_of_range_1 == 0);
     REQUIRE(out_of_range_2 == 0);
     REQUIRE_THROWS(model_2.read_params("bad_params_test.yaml", true));